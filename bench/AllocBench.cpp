@@ -0,0 +1,229 @@
+/**
+ * @file AllocBench.cpp
+ * @brief Counts heap allocations per pizza on the pizza steps of the order
+ * path, with the heap-allocated polymorphic pizzas of before and with the
+ * recipe table, by replacing the global operator new.
+ *
+ * Each order creates its pizza when it is queued, reads its ingredients,
+ * creates it again when a cook is assigned, and copies it into the task of
+ * the cook. Tasks go to a buffer reserved up front, so only the pizzas are
+ * counted.
+ *
+ * Usage: alloc_bench [PIZZAS]
+ * Exits with 1 if the recipe table path allocates.
+ */
+
+#include "Communication/Serialization.hpp"
+#include "Core/Pizza.hpp"
+#include "Kitchen/Cook.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace Core = Plazza::Core;
+
+namespace {
+std::atomic<uint64_t> allocations{0};
+} // namespace
+
+void *operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *memory = std::malloc(size ? size : 1)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+namespace Legacy {
+/**
+ * @class Pizza
+ * @brief The pizza replaced by the recipe table: a polymorphic base owning
+ * its ingredients in a vector, created on the heap by a factory.
+ */
+class Pizza {
+public:
+  Pizza(Core::PizzaType type, Core::PizzaSize size)
+      : m_type(type), m_size(size) {}
+  virtual ~Pizza() = default;
+
+  static std::unique_ptr<Pizza> createPizza(Core::PizzaType type,
+                                            Core::PizzaSize size);
+
+  [[nodiscard]] Core::PizzaType getType() const { return m_type; }
+  [[nodiscard]] const std::vector<Core::Ingredient> &getIngredients() const {
+    return m_ingredients;
+  }
+  [[nodiscard]] double getCookingTime(double multiplier) const {
+    return m_baseCookingTime * multiplier;
+  }
+
+protected:
+  Core::PizzaType m_type;
+  Core::PizzaSize m_size;
+  std::vector<Core::Ingredient> m_ingredients;
+  int m_baseCookingTime = 0;
+};
+
+class MargaritaPizza : public Pizza {
+public:
+  explicit MargaritaPizza(Core::PizzaSize size)
+      : Pizza(Core::PizzaType::Margarita, size) {
+    m_ingredients = {Core::Ingredient::Dough, Core::Ingredient::Tomato,
+                     Core::Ingredient::Gruyere};
+    m_baseCookingTime = 1;
+  }
+};
+
+class ReginaPizza : public Pizza {
+public:
+  explicit ReginaPizza(Core::PizzaSize size)
+      : Pizza(Core::PizzaType::Regina, size) {
+    m_ingredients = {Core::Ingredient::Dough, Core::Ingredient::Tomato,
+                     Core::Ingredient::Gruyere, Core::Ingredient::Ham,
+                     Core::Ingredient::Mushrooms};
+    m_baseCookingTime = 2;
+  }
+};
+
+class AmericanaPizza : public Pizza {
+public:
+  explicit AmericanaPizza(Core::PizzaSize size)
+      : Pizza(Core::PizzaType::Americana, size) {
+    m_ingredients = {Core::Ingredient::Dough, Core::Ingredient::Tomato,
+                     Core::Ingredient::Gruyere, Core::Ingredient::Steak};
+    m_baseCookingTime = 2;
+  }
+};
+
+class FantasiaPizza : public Pizza {
+public:
+  explicit FantasiaPizza(Core::PizzaSize size)
+      : Pizza(Core::PizzaType::Fantasia, size) {
+    m_ingredients = {Core::Ingredient::Dough, Core::Ingredient::Tomato,
+                     Core::Ingredient::Eggplant, Core::Ingredient::GoatCheese,
+                     Core::Ingredient::ChiefLove};
+    m_baseCookingTime = 4;
+  }
+};
+
+std::unique_ptr<Pizza> Pizza::createPizza(Core::PizzaType type,
+                                          Core::PizzaSize size) {
+  switch (type) {
+  case Core::PizzaType::Margarita:
+    return std::make_unique<MargaritaPizza>(size);
+  case Core::PizzaType::Regina:
+    return std::make_unique<ReginaPizza>(size);
+  case Core::PizzaType::Americana:
+    return std::make_unique<AmericanaPizza>(size);
+  default:
+    return std::make_unique<FantasiaPizza>(size);
+  }
+}
+
+/**
+ * @struct CookingTask
+ * @brief The task of a cook, holding a sliced copy of the pizza.
+ */
+struct CookingTask {
+  Plazza::Communication::PizzaOrder order;
+  Pizza pizza;
+};
+} // namespace Legacy
+
+constexpr Core::PizzaType TYPES[] = {
+    Core::PizzaType::Regina, Core::PizzaType::Margarita,
+    Core::PizzaType::Americana, Core::PizzaType::Fantasia};
+
+std::vector<Plazza::Communication::PizzaOrder> makeOrders(std::size_t count) {
+  std::vector<Plazza::Communication::PizzaOrder> orders(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    orders[i].type = TYPES[i % 4];
+    orders[i].size = Core::PizzaSize::M;
+    orders[i].quantity = 1;
+    orders[i].orderId = i + 1;
+  }
+  return orders;
+}
+
+struct Result {
+  double allocationsPerPizza = 0;
+  double nanosPerPizza = 0;
+};
+
+template <typename Path>
+Result measure(const std::vector<Plazza::Communication::PizzaOrder> &orders,
+               Path path) {
+  uint64_t before = allocations.load();
+  auto start = Clock::now();
+  path();
+  auto elapsed = Clock::now() - start;
+  auto pizzas = static_cast<double>(orders.size());
+  return {static_cast<double>(allocations.load() - before) / pizzas,
+          std::chrono::duration<double, std::nano>(elapsed).count() / pizzas};
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::stoul(argv[1]) : 1 << 20;
+  auto orders = makeOrders(count);
+  double cookingTime = 0;
+  std::size_t ingredients = 0;
+
+  std::vector<Legacy::CookingTask> legacyTasks;
+  legacyTasks.reserve(count);
+  Result legacy = measure(orders, [&]() {
+    for (const auto &order : orders) {
+      auto queued = Legacy::Pizza::createPizza(order.type, order.size);
+      cookingTime += queued->getCookingTime(1.0);
+      ingredients += queued->getIngredients().size();
+      auto started = Legacy::Pizza::createPizza(order.type, order.size);
+      legacyTasks.push_back({order, *started});
+    }
+  });
+
+  std::vector<Plazza::Kitchen::CookingTask> tasks;
+  tasks.reserve(count);
+  Result table = measure(orders, [&]() {
+    for (const auto &order : orders) {
+      Core::Pizza queued = Core::Pizza::createPizza(order.type, order.size);
+      cookingTime += queued.getCookingTime(1.0);
+      ingredients += Core::laneCount(queued.getIngredients(),
+                                     Core::Ingredient::Dough);
+      Core::Pizza started = Core::Pizza::createPizza(order.type, order.size);
+      tasks.push_back({order, started, 0, 0});
+    }
+  });
+
+  std::cout << count << " pizzas" << std::endl;
+  std::cout << std::left << std::setw(14) << "pizzas" << std::setw(18)
+            << "allocs/pizza" << "ns/pizza" << std::endl;
+  std::cout << std::fixed << std::setprecision(2) << std::setw(14)
+            << "polymorphic" << std::setw(18) << legacy.allocationsPerPizza
+            << legacy.nanosPerPizza << std::endl;
+  std::cout << std::setw(14) << "recipe table" << std::setw(18)
+            << table.allocationsPerPizza << table.nanosPerPizza << std::endl;
+  std::cout << "(" << cookingTime << " s of cooking, " << ingredients
+            << " ingredients, " << legacyTasks.size() + tasks.size()
+            << " tasks)" << std::endl;
+
+  if (table.allocationsPerPizza > 0) {
+    std::cerr << "The recipe table path allocates" << std::endl;
+    return 1;
+  }
+  return 0;
+}
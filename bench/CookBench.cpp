@@ -0,0 +1,171 @@
+/**
+ * @file CookBench.cpp
+ * @brief Measures how often idle cooks wake up, and how long an assigned
+ * pizza waits before a cook starts it, for each cook model and for the 10 ms
+ * polling loop cooks ran before they blocked on the work queue.
+ *
+ * Usage: cook_bench [COOKS] [IDLE_MS] [SAMPLES]
+ */
+
+#include "Core/ThreadQueue.hpp"
+#include "Kitchen/CookPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+namespace Kitchen = Plazza::Kitchen;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @class PollingCookPool
+ * @brief The cooking loop used before cooks blocked on their queue: every
+ * idle cook polls the queue, then sleeps 10 ms.
+ */
+class PollingCookPool : public Kitchen::CookPool {
+public:
+  PollingCookPool(uint32_t cookCount, Callback callback)
+      : m_cookCount(cookCount), m_callback(std::move(callback)) {}
+
+  ~PollingCookPool() override { stop(); }
+
+  void start() override {
+    for (uint32_t i = 0; i < m_cookCount; ++i) {
+      m_cooks.emplace_back([this](std::stop_token stopToken) {
+        while (!stopToken.stop_requested()) {
+          auto task = m_workQueue.tryPop();
+          if (task) {
+            m_callback(*task);
+          } else {
+            std::this_thread::yield();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          }
+        }
+      });
+    }
+  }
+
+  void stop() override { m_cooks.clear(); }
+
+  void submit(const Kitchen::CookingTask &task) override {
+    m_workQueue.push(task);
+  }
+
+  void resize(uint32_t cookCount) override { m_cookCount = cookCount; }
+
+  [[nodiscard]] uint32_t busyCooks() const override { return 0; }
+
+private:
+  uint32_t m_cookCount;
+  Callback m_callback;
+  Plazza::Core::ThreadQueue<Kitchen::CookingTask> m_workQueue;
+  std::vector<std::jthread> m_cooks;
+};
+
+long voluntarySwitches(int who) {
+  rusage usage{};
+  getrusage(who, &usage);
+  return usage.ru_nvcsw;
+}
+
+struct Result {
+  double wakeupsPerSecond = 0;
+  double p50 = 0;
+  double p99 = 0;
+  double max = 0;
+};
+
+Result measure(const std::string &model, uint32_t cooks,
+               std::chrono::milliseconds idle, std::size_t samples) {
+  std::mutex mutex;
+  std::condition_variable started;
+  std::size_t startedCount = 0;
+  Clock::time_point startedAt;
+
+  auto callback = [&](const Kitchen::CookingTask &) {
+    std::lock_guard<std::mutex> lock(mutex);
+    startedAt = Clock::now();
+    ++startedCount;
+    started.notify_one();
+  };
+
+  std::unique_ptr<Kitchen::CookPool> pool;
+  if (model == "poll-10ms") {
+    pool = std::make_unique<PollingCookPool>(cooks, callback);
+  } else {
+    pool = Kitchen::CookPool::create(model == "coroutines"
+                                         ? Kitchen::CookModel::Coroutines
+                                         : Kitchen::CookModel::Threads,
+                                     cooks, callback, 0.0);
+  }
+  pool->start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  Result result;
+  long process = voluntarySwitches(RUSAGE_SELF);
+  long self = voluntarySwitches(RUSAGE_THREAD);
+  auto idleStart = Clock::now();
+  std::this_thread::sleep_for(idle);
+  double seconds =
+      std::chrono::duration<double>(Clock::now() - idleStart).count();
+  long cookSwitches = (voluntarySwitches(RUSAGE_SELF) - process) -
+                      (voluntarySwitches(RUSAGE_THREAD) - self);
+  result.wakeupsPerSecond = static_cast<double>(cookSwitches) / seconds;
+
+  Kitchen::CookingTask task{};
+  task.pizza = Plazza::Core::Pizza(Plazza::Core::PizzaType::Margarita,
+                                   Plazza::Core::PizzaSize::S);
+  std::vector<double> latencies;
+  for (std::size_t i = 0; i < samples; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    std::unique_lock<std::mutex> lock(mutex);
+    std::size_t before = startedCount;
+    auto submittedAt = Clock::now();
+    pool->submit(task);
+    started.wait(lock, [&]() { return startedCount > before; });
+    latencies.push_back(
+        std::chrono::duration<double, std::micro>(startedAt - submittedAt)
+            .count());
+  }
+  pool->stop();
+
+  std::sort(latencies.begin(), latencies.end());
+  if (!latencies.empty()) {
+    result.p50 = latencies[latencies.size() / 2];
+    result.p99 = latencies[latencies.size() * 99 / 100];
+    result.max = latencies.back();
+  }
+  return result;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  uint32_t cooks = argc > 1 ? std::stoul(argv[1]) : 8;
+  std::chrono::milliseconds idle(argc > 2 ? std::stoul(argv[2]) : 1000);
+  std::size_t samples = argc > 3 ? std::stoul(argv[3]) : 500;
+
+  std::cout << cooks << " cooks, idle for " << idle.count() << " ms, "
+            << samples << " pizzas" << std::endl;
+  std::cout << std::left << std::setw(12) << "model" << std::setw(18)
+            << "idle wakeups/s" << std::setw(12) << "start p50" << std::setw(12)
+            << "start p99" << "start max (us)" << std::endl;
+
+  for (const char *model : {"poll-10ms", "threads", "coroutines"}) {
+    Result result = measure(model, cooks, idle, samples);
+    std::cout << std::setw(12) << model << std::setw(18) << std::fixed
+              << std::setprecision(1) << result.wakeupsPerSecond
+              << std::setw(12) << result.p50 << std::setw(12) << result.p99
+              << result.max << std::endl;
+  }
+  return 0;
+}
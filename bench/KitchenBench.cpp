@@ -0,0 +1,192 @@
+/**
+ * @file KitchenBench.cpp
+ * @brief Compares kitchens run as forked processes with kitchens run as
+ * threads of the reception: throughput of a batch of pizzas, latency of a
+ * single pizza from dispatch to completion, and the memory the reception
+ * and its kitchens use.
+ *
+ * Pizzas cook in a fraction of a millisecond and the stock is always full,
+ * so the numbers show the cost of hosting and messaging the kitchens.
+ *
+ * Usage: kitchen_bench [KITCHENS] [COOKS] [PIZZAS] [SAMPLES]
+ */
+
+#include "Logger/Logger.hpp"
+#include "Reception/KitchenManager.hpp"
+#include "Reception/OrderRun.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <sys/types.h>
+#include <unistd.h>
+#include <vector>
+
+namespace Reception = Plazza::Reception;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr double TIME_MULTIPLIER = 0.0001;
+
+struct Result {
+  double pizzasPerSecond = 0;
+  double p50 = 0;
+  double p99 = 0;
+  double rssMegabytes = 0;
+  double pssMegabytes = 0;
+};
+
+pid_t parentOf(const std::filesystem::path &process) {
+  std::ifstream stat(process / "stat");
+  std::string line;
+  std::getline(stat, line);
+  std::size_t end = line.rfind(')');
+  if (end == std::string::npos) {
+    return 0;
+  }
+  std::istringstream fields(line.substr(end + 2));
+  char state = 0;
+  pid_t parent = 0;
+  fields >> state >> parent;
+  return parent;
+}
+
+/**
+ * @brief Reads a field of /proc/PID/smaps_rollup.
+ * @return The field in kilobytes, 0 if the process is gone.
+ */
+uint64_t rollupKilobytes(pid_t pid, const std::string &field) {
+  std::ifstream rollup("/proc/" + std::to_string(pid) + "/smaps_rollup");
+  std::string name;
+  uint64_t kilobytes = 0;
+  while (rollup >> name) {
+    if (name == field) {
+      rollup >> kilobytes;
+      return kilobytes;
+    }
+    rollup.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  }
+  return 0;
+}
+
+/**
+ * @brief Sums the memory of this process and of its descendants. RSS counts
+ * pages shared after fork once per process; PSS splits them among the
+ * processes sharing them.
+ */
+void measureMemory(Result &result) {
+  std::vector<pid_t> family{getpid()};
+  for (std::size_t i = 0; i < family.size(); ++i) {
+    for (const auto &entry : std::filesystem::directory_iterator("/proc")) {
+      std::string name = entry.path().filename();
+      if (std::all_of(name.begin(), name.end(), ::isdigit) &&
+          parentOf(entry.path()) == family[i]) {
+        family.push_back(std::stoi(name));
+      }
+    }
+  }
+
+  uint64_t rss = 0;
+  uint64_t pss = 0;
+  for (pid_t pid : family) {
+    rss += rollupKilobytes(pid, "Rss:");
+    pss += rollupKilobytes(pid, "Pss:");
+  }
+  result.rssMegabytes = static_cast<double>(rss) / 1024;
+  result.pssMegabytes = static_cast<double>(pss) / 1024;
+}
+
+std::vector<Reception::OrderRun> makeRuns(uint64_t &nextOrderId,
+                                          uint32_t count) {
+  Reception::OrderRun run;
+  run.type = Plazza::Core::PizzaType::Margarita;
+  run.size = Plazza::Core::PizzaSize::S;
+  run.count = count;
+  run.firstOrderId = nextOrderId;
+  nextOrderId += count;
+  return {run};
+}
+
+Result measure(Reception::KitchenHosting hosting, uint32_t kitchens,
+               uint32_t cooks, uint32_t pizzas, std::size_t samples) {
+  Reception::Settings settings;
+  settings.timeMultiplier = TIME_MULTIPLIER;
+  settings.cooksPerKitchen = cooks;
+  settings.stockRestockTime = std::chrono::milliseconds(0);
+  settings.kitchenHosting = hosting;
+  settings.maxKitchens = kitchens;
+  settings.maxQueuedRuns = pizzas;
+
+  Reception::KitchenManager manager(settings);
+  uint64_t nextOrderId = 1;
+  Result result;
+
+  // Starts the kitchens before timing anything.
+  manager.distributeOrder(makeRuns(nextOrderId, pizzas));
+  manager.waitUntilIdle();
+
+  auto start = Clock::now();
+  manager.distributeOrder(makeRuns(nextOrderId, pizzas));
+  manager.waitUntilIdle();
+  result.pizzasPerSecond =
+      pizzas / std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<double> latencies;
+  for (std::size_t i = 0; i < samples; ++i) {
+    auto dispatchedAt = Clock::now();
+    manager.distributeOrder(makeRuns(nextOrderId, 1));
+    manager.waitUntilIdle();
+    latencies.push_back(std::chrono::duration<double, std::micro>(
+                            Clock::now() - dispatchedAt)
+                            .count());
+  }
+  std::sort(latencies.begin(), latencies.end());
+  if (!latencies.empty()) {
+    result.p50 = latencies[latencies.size() / 2];
+    result.p99 = latencies[latencies.size() * 99 / 100];
+  }
+
+  measureMemory(result);
+  manager.drain();
+  return result;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  uint32_t kitchens = argc > 1 ? std::stoul(argv[1]) : 4;
+  uint32_t cooks = argc > 2 ? std::stoul(argv[2]) : 4;
+  uint32_t pizzas = argc > 3 ? std::stoul(argv[3]) : 20000;
+  std::size_t samples = argc > 4 ? std::stoul(argv[4]) : 500;
+
+  Plazza::Logger::Logger::getInstance().setLogLevel(
+      Plazza::Logger::LogLevel::WARN);
+  std::cout << kitchens << " kitchens of " << cooks << " cooks, " << pizzas
+            << " pizzas, " << samples << " single pizzas" << std::endl;
+  std::cout << std::left << std::setw(11) << "hosting" << std::setw(12)
+            << "pizzas/s" << std::setw(10) << "p50 (us)" << std::setw(10)
+            << "p99 (us)" << std::setw(10) << "RSS (MB)" << "PSS (MB)"
+            << std::endl;
+
+  for (auto hosting : {Reception::KitchenHosting::Processes,
+                       Reception::KitchenHosting::Threads}) {
+    Result result = measure(hosting, kitchens, cooks, pizzas, samples);
+    std::cout << std::setw(11)
+              << (hosting == Reception::KitchenHosting::Processes
+                      ? "processes"
+                      : "threads")
+              << std::fixed << std::setprecision(0) << std::setw(12)
+              << result.pizzasPerSecond << std::setw(10) << result.p50
+              << std::setw(10) << result.p99 << std::setprecision(1)
+              << std::setw(10) << result.rssMegabytes << result.pssMegabytes
+              << std::endl;
+  }
+  return 0;
+}
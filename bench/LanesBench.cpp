@@ -0,0 +1,196 @@
+/**
+ * @file LanesBench.cpp
+ * @brief Checks the feasibility kernels of Core::feasibleMask against the
+ * scalar kernel and against the per-ingredient map loop they replaced, then
+ * times them.
+ *
+ * Usage: lanes_bench [RECIPES] [ROUNDS]
+ * Exits with 1 if a kernel disagrees with the reference.
+ */
+
+#include "Core/IngredientLanes.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Core = Plazza::Core;
+
+namespace {
+using Counts = std::map<Core::Ingredient, uint32_t>;
+
+constexpr std::size_t STOCKS = 64;
+
+struct Kernel {
+  const char *name;
+  Core::LaneKernel kernel;
+};
+
+constexpr Kernel KERNELS[] = {{"scalar", Core::LaneKernel::Scalar},
+                              {"sse2", Core::LaneKernel::Sse2},
+                              {"avx2", Core::LaneKernel::Avx2}};
+
+Counts toCounts(Core::IngredientLanes lanes) {
+  Counts counts;
+  for (uint32_t i = 0; i < Core::INGREDIENT_COUNT; ++i) {
+    auto ingredient = static_cast<Core::Ingredient>(i);
+    if (Core::laneCount(lanes, ingredient) > 0) {
+      counts[ingredient] = Core::laneCount(lanes, ingredient);
+    }
+  }
+  return counts;
+}
+
+Core::IngredientLanes randomLanes(std::mt19937_64 &random, uint64_t max) {
+  std::uniform_int_distribution<uint64_t> count(0, max);
+  Core::IngredientLanes lanes = 0;
+  for (uint32_t i = 0; i < Core::INGREDIENT_COUNT; ++i) {
+    lanes |= count(random) << (i * Core::LANE_BITS);
+  }
+  return lanes;
+}
+
+/**
+ * @brief The check the kernels replaced: the stock as a map, and every
+ * ingredient of every recipe looked up in it.
+ */
+void feasibleMaskMap(const Counts &stock, const std::vector<Counts> &needs,
+                     uint64_t *mask) {
+  std::fill(mask, mask + (needs.size() + 63) / 64, 0);
+  for (std::size_t i = 0; i < needs.size(); ++i) {
+    bool feasible = true;
+    for (const auto &[ingredient, count] : needs[i]) {
+      auto it = stock.find(ingredient);
+      if (it == stock.end() || it->second < count) {
+        feasible = false;
+        break;
+      }
+    }
+    if (feasible) {
+      mask[i / 64] |= 1ULL << (i % 64);
+    }
+  }
+}
+
+template <typename Check> double nanosPerRecipe(std::size_t work, Check check) {
+  auto start = std::chrono::steady_clock::now();
+  check();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(work);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t recipeCount = argc > 1 ? std::stoul(argv[1]) : 1 << 16;
+  std::size_t rounds = argc > 2 ? std::stoul(argv[2]) : 20;
+
+  std::mt19937_64 random(42);
+  std::vector<Core::IngredientLanes> stocks;
+  for (std::size_t i = 0; i < STOCKS; ++i) {
+    stocks.push_back(randomLanes(random, i % 8 == 0 ? Core::LANE_MAX : 6));
+  }
+  stocks.push_back(0);
+  stocks.push_back(Core::broadcastLanes(Core::LANE_MAX));
+
+  std::vector<Core::IngredientLanes> needs;
+  for (std::size_t i = 0; i < recipeCount; ++i) {
+    needs.push_back(randomLanes(random, i % 16 == 0 ? Core::LANE_MAX : 3));
+  }
+  needs.insert(needs.end(), stocks.begin(), stocks.end());
+
+  std::vector<Counts> needCounts;
+  for (auto need : needs) {
+    needCounts.push_back(toCounts(need));
+  }
+
+  std::vector<std::size_t> sizes;
+  for (std::size_t count = 0; count < std::min<std::size_t>(130, needs.size());
+       ++count) {
+    sizes.push_back(count);
+  }
+  sizes.push_back(needs.size());
+
+  std::size_t words = (needs.size() + 63) / 64;
+  std::vector<uint64_t> expected(words);
+  std::vector<uint64_t> actual(words);
+  int failures = 0;
+
+  for (auto stock : stocks) {
+    feasibleMaskMap(toCounts(stock), needCounts, expected.data());
+    for (const auto &kernel : KERNELS) {
+      if (!Core::laneKernelSupported(kernel.kernel)) {
+        continue;
+      }
+      for (std::size_t count : sizes) {
+        Core::feasibleMask(stock, needs.data(), count, actual.data(),
+                           kernel.kernel);
+        for (std::size_t i = 0; i < count; ++i) {
+          bool want = (expected[i / 64] >> (i % 64)) & 1;
+          bool got = (actual[i / 64] >> (i % 64)) & 1;
+          if (want != got) {
+            std::cerr << kernel.name << " disagrees with the map loop on "
+                      << "stock 0x" << std::hex << stock << " need 0x"
+                      << needs[i] << std::dec << " (" << count
+                      << " recipes)" << std::endl;
+            ++failures;
+            break;
+          }
+        }
+      }
+    }
+  }
+  if (failures > 0) {
+    return 1;
+  }
+
+  std::size_t work = rounds * stocks.size() * needs.size();
+  std::size_t feasible = 0;
+  std::vector<Counts> stockCounts;
+  for (auto stock : stocks) {
+    stockCounts.push_back(toCounts(stock));
+  }
+
+  double mapNanos = nanosPerRecipe(work, [&]() {
+    for (std::size_t round = 0; round < rounds; ++round) {
+      for (const auto &stock : stockCounts) {
+        feasibleMaskMap(stock, needCounts, expected.data());
+        feasible += std::popcount(expected[0]);
+      }
+    }
+  });
+
+  std::cout << "Checked " << needs.size() << " recipes against "
+            << stocks.size() << " stocks, all kernels agree" << std::endl;
+  std::cout << std::left << std::setw(10) << "kernel" << std::setw(14)
+            << "ns/recipe" << "speedup" << std::endl;
+  std::cout << std::setw(10) << "map" << std::setw(14) << std::fixed
+            << std::setprecision(3) << mapNanos << "1.0x" << std::endl;
+
+  for (const auto &kernel : KERNELS) {
+    if (!Core::laneKernelSupported(kernel.kernel)) {
+      continue;
+    }
+    double nanos = nanosPerRecipe(work, [&]() {
+      for (std::size_t round = 0; round < rounds; ++round) {
+        for (auto stock : stocks) {
+          Core::feasibleMask(stock, needs.data(), needs.size(), actual.data(),
+                             kernel.kernel);
+          feasible += std::popcount(actual[0]);
+        }
+      }
+    });
+    std::cout << std::setw(10) << kernel.name << std::setw(14) << nanos
+              << std::setprecision(1) << mapNanos / nanos << "x"
+              << std::setprecision(3) << std::endl;
+  }
+
+  std::cout << "(" << feasible << " feasible in the first words)" << std::endl;
+  return 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file ParserBench.cpp
+ * @brief Compares OrderParser::parse with the std::regex parser it replaced
+ * on one long pasted line of orders: both must read the same pizzas, then
+ * both are timed.
+ *
+ * Usage: parser_bench [LINE_BYTES] [ROUNDS]
+ * Exits with 1 if the parsers disagree.
+ */
+
+#include "Core/Pizza.hpp"
+#include "Reception/OrderParser.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Core = Plazza::Core;
+namespace Reception = Plazza::Reception;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @struct ParsedPizza
+ * @brief One pizza as both parsers see it.
+ */
+struct ParsedPizza {
+  Core::PizzaType type;
+  Core::PizzaSize size;
+  bool hasDeadline;
+
+  bool operator==(const ParsedPizza &) const = default;
+};
+
+const std::regex ORDER_REGEX(
+    R"(([a-zA-Z]+)\s+(S|M|L|XL|XXL)\s+x(\d+)(?:\s+@(\d+))?)",
+    std::regex_constants::icase);
+
+Core::PizzaType regexType(const std::string &name) {
+  std::string lower = name;
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  if (lower == "regina")
+    return Core::PizzaType::Regina;
+  if (lower == "margarita")
+    return Core::PizzaType::Margarita;
+  if (lower == "americana")
+    return Core::PizzaType::Americana;
+  if (lower == "fantasia")
+    return Core::PizzaType::Fantasia;
+  throw std::invalid_argument("Invalid pizza type: " + name);
+}
+
+Core::PizzaSize regexSize(const std::string &name) {
+  std::string upper = name;
+  std::transform(upper.begin(), upper.end(), upper.begin(),
+                 [](unsigned char c) { return std::toupper(c); });
+  if (upper == "S")
+    return Core::PizzaSize::S;
+  if (upper == "M")
+    return Core::PizzaSize::M;
+  if (upper == "L")
+    return Core::PizzaSize::L;
+  if (upper == "XL")
+    return Core::PizzaSize::XL;
+  return Core::PizzaSize::XXL;
+}
+
+/**
+ * @brief The parser replaced by the scanner: the line split with getline,
+ * each order trimmed into a copy and matched with std::regex, then expanded
+ * into one order per pizza.
+ */
+std::vector<ParsedPizza> regexParse(const std::string &input) {
+  std::vector<ParsedPizza> pizzas;
+  std::istringstream stream(input);
+  std::string orderPart;
+
+  while (std::getline(stream, orderPart, ';')) {
+    orderPart.erase(0, orderPart.find_first_not_of(" \t"));
+    orderPart.erase(orderPart.find_last_not_of(" \t") + 1);
+    if (orderPart.empty())
+      continue;
+
+    std::smatch match;
+    if (!std::regex_match(orderPart, match, ORDER_REGEX)) {
+      throw std::invalid_argument("Invalid order format: " + orderPart);
+    }
+    ParsedPizza pizza{regexType(match[1].str()), regexSize(match[2].str()),
+                      match[4].matched};
+    uint32_t quantity = std::stoul(match[3].str());
+    for (uint32_t i = 0; i < quantity; ++i) {
+      pizzas.push_back(pizza);
+    }
+  }
+  return pizzas;
+}
+
+std::vector<ParsedPizza> scannerParse(const std::string &input) {
+  std::vector<Reception::OrderRun> runs;
+  Reception::ParseError error = Reception::OrderParser::parse(input, runs);
+  if (error) {
+    throw std::invalid_argument(Reception::OrderParser::describe(error));
+  }
+
+  std::vector<ParsedPizza> pizzas;
+  for (const auto &run : runs) {
+    pizzas.insert(pizzas.end(), run.count,
+                  {run.type, run.size, run.deadline != 0});
+  }
+  return pizzas;
+}
+
+std::string makeLine(std::size_t bytes) {
+  const char *types[] = {"regina", "Margarita", "AMERICANA", "fantasia"};
+  const char *sizes[] = {"S", "m", "L", "XL", "xxl"};
+  std::mt19937 random(42);
+  std::string line;
+
+  while (line.size() < bytes) {
+    line += types[random() % 4];
+    line += random() % 2 ? " " : "  ";
+    line += sizes[random() % 5];
+    line += " x" + std::to_string(random() % 5 + 1);
+    if (random() % 4 == 0) {
+      line += " @" + std::to_string(random() % 120);
+    }
+    line += random() % 2 ? "; " : ";";
+  }
+  return line;
+}
+
+template <typename Parse>
+double millisPerRound(std::size_t rounds, std::size_t &pizzas, Parse parse) {
+  auto start = Clock::now();
+  for (std::size_t round = 0; round < rounds; ++round) {
+    pizzas = parse().size();
+  }
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+             .count() /
+         static_cast<double>(rounds);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t bytes = argc > 1 ? std::stoul(argv[1]) : 1 << 20;
+  std::size_t rounds = argc > 2 ? std::stoul(argv[2]) : 5;
+  std::string line = makeLine(bytes);
+
+  if (regexParse(line) != scannerParse(line)) {
+    std::cerr << "The parsers read different pizzas" << std::endl;
+    return 1;
+  }
+
+  std::size_t regexPizzas = 0;
+  std::size_t scannerPizzas = 0;
+  double regexMillis =
+      millisPerRound(rounds, regexPizzas, [&]() { return regexParse(line); });
+  double scannerMillis = millisPerRound(rounds, scannerPizzas, [&]() {
+    std::vector<Reception::OrderRun> runs;
+    Reception::OrderParser::parse(line, runs);
+    return runs;
+  });
+
+  double megabytes = static_cast<double>(line.size()) / (1 << 20);
+  std::cout << "One line of " << line.size() << " bytes, " << regexPizzas
+            << " pizzas in " << scannerPizzas << " orders, both parsers agree"
+            << std::endl;
+  std::cout << std::left << std::setw(10) << "parser" << std::setw(12) << "ms"
+            << "MB/s" << std::endl;
+  std::cout << std::fixed << std::setprecision(2) << std::setw(10) << "regex"
+            << std::setw(12) << regexMillis << megabytes * 1000 / regexMillis
+            << std::endl;
+  std::cout << std::setw(10) << "scanner" << std::setw(12) << scannerMillis
+            << megabytes * 1000 / scannerMillis << std::endl;
+  std::cout << "speedup " << regexMillis / scannerMillis << "x" << std::endl;
+  return 0;
+}
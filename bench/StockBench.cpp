@@ -0,0 +1,244 @@
+/**
+ * @file StockBench.cpp
+ * @brief Has N cooks contend on one stock: first checks that racing cooks
+ * never take more than the stock holds, then times reservations on
+ * Kitchen::Stock against the mutex-guarded map it replaced, while a status
+ * reader keeps taking snapshots.
+ *
+ * Usage: stock_bench [MAX_COOKS] [MILLIS_PER_RUN]
+ * Exits with 1 if the stock loses or invents ingredients.
+ */
+
+#include "Core/IngredientLanes.hpp"
+#include "Core/Pizza.hpp"
+#include "Kitchen/Stock.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Core = Plazza::Core;
+namespace Kitchen = Plazza::Kitchen;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr Core::PizzaType TYPES[] = {
+    Core::PizzaType::Regina, Core::PizzaType::Margarita,
+    Core::PizzaType::Americana, Core::PizzaType::Fantasia};
+
+std::vector<Core::Ingredient> toList(Core::IngredientLanes lanes) {
+  std::vector<Core::Ingredient> ingredients;
+  for (uint32_t i = 0; i < Core::INGREDIENT_COUNT; ++i) {
+    auto ingredient = static_cast<Core::Ingredient>(i);
+    for (uint32_t n = 0; n < Core::laneCount(lanes, ingredient); ++n) {
+      ingredients.push_back(ingredient);
+    }
+  }
+  return ingredients;
+}
+
+/**
+ * @class MapStock
+ * @brief The stock the lanes replaced: a map behind one mutex, held while
+ * the reservation runs, and refilled by a restock thread.
+ */
+class MapStock {
+public:
+  MapStock() {
+    for (uint32_t i = 0; i < Core::INGREDIENT_COUNT; ++i) {
+      m_stock[static_cast<Core::Ingredient>(i)] = UINT32_MAX / 2;
+    }
+    m_restock = std::jthread([this](std::stop_token stopToken) {
+      while (!stopToken.stop_requested()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto &[ingredient, count] : m_stock) {
+          ++count;
+        }
+      }
+    });
+  }
+
+  bool consumeIngredients(const std::vector<Core::Ingredient> &ingredients,
+                          const std::function<bool()> &reservation) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto ingredient : ingredients) {
+      if (m_stock[ingredient] == 0) {
+        return false;
+      }
+    }
+    for (auto ingredient : ingredients) {
+      --m_stock[ingredient];
+    }
+    if (!reservation()) {
+      for (auto ingredient : ingredients) {
+        ++m_stock[ingredient];
+      }
+      return false;
+    }
+    return true;
+  }
+
+  std::map<Core::Ingredient, uint32_t> getStock() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stock;
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::map<Core::Ingredient, uint32_t> m_stock;
+  std::jthread m_restock;
+};
+
+/**
+ * @brief Races cooks for a stock that is never restocked, each taking
+ * pizzas until the stock cannot cover its next one, and checks every
+ * ingredient taken is accounted for.
+ */
+bool checkConservation(uint32_t cooks) {
+  constexpr uint32_t INITIAL = Core::LANE_MAX;
+  Kitchen::Stock stock(std::chrono::hours(1), INITIAL);
+  std::vector<std::array<uint64_t, 4>> taken(cooks);
+  std::vector<std::jthread> threads;
+
+  for (uint32_t cook = 0; cook < cooks; ++cook) {
+    threads.emplace_back([&, cook]() {
+      for (uint32_t i = cook;; ++i) {
+        Core::IngredientLanes need =
+            Core::recipeOf(TYPES[i % 4]).ingredients;
+        if (!stock.consumeIngredients(need, []() { return true; })) {
+          if (!Core::lanesCover(stock.getLanes(), need)) {
+            return;
+          }
+          continue;
+        }
+        ++taken[cook][i % 4];
+      }
+    });
+  }
+  threads.clear();
+
+  Core::IngredientLanes left = stock.getLanes();
+  for (uint32_t i = 0; i < Core::INGREDIENT_COUNT; ++i) {
+    auto ingredient = static_cast<Core::Ingredient>(i);
+    uint64_t total = Core::laneCount(left, ingredient);
+    for (const auto &pizzas : taken) {
+      for (std::size_t type = 0; type < 4; ++type) {
+        total += pizzas[type] * Core::laneCount(
+                                    Core::recipeOf(TYPES[type]).ingredients,
+                                    ingredient);
+      }
+    }
+    if (total != INITIAL) {
+      std::cerr << cooks << " cooks: " << Core::toString(ingredient)
+                << " left and taken add up to " << total << " instead of "
+                << INITIAL << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Runs cooks reserving pizzas for a while, with a status reader
+ * taking a snapshot every millisecond.
+ * @return Reservations per second across all cooks.
+ */
+template <typename Reserve, typename Snapshot>
+double reservationsPerSecond(uint32_t cooks, std::chrono::milliseconds run,
+                             Reserve reserve, Snapshot snapshot) {
+  std::atomic<bool> stop{false};
+  std::atomic<uint64_t> reserved{0};
+  std::atomic<uint32_t> queued{0};
+  std::vector<std::jthread> threads;
+
+  auto start = Clock::now();
+  for (uint32_t cook = 0; cook < cooks; ++cook) {
+    threads.emplace_back([&, cook]() {
+      uint64_t count = 0;
+      std::string line;
+      for (uint32_t i = cook; !stop.load(std::memory_order_relaxed); ++i) {
+        std::size_t index = i % 4;
+        auto type = TYPES[index];
+        count += reserve(index, [&]() {
+          queued.fetch_add(1, std::memory_order_relaxed);
+          line = "Cook " + std::to_string(cook) + " takes " +
+                 Core::toString(type);
+          return true;
+        });
+      }
+      reserved += count;
+    });
+  }
+  threads.emplace_back([&]() {
+    while (!stop.load(std::memory_order_relaxed)) {
+      snapshot();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+
+  std::this_thread::sleep_for(run);
+  stop = true;
+  threads.clear();
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  return static_cast<double>(reserved.load()) / seconds;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  uint32_t maxCooks = argc > 1 ? std::stoul(argv[1]) : 16;
+  std::chrono::milliseconds run(argc > 2 ? std::stoul(argv[2]) : 500);
+
+  std::vector<uint32_t> cookCounts;
+  for (uint32_t cooks = 1; cooks <= maxCooks; cooks *= 2) {
+    cookCounts.push_back(cooks);
+  }
+
+  for (uint32_t cooks : cookCounts) {
+    if (!checkConservation(cooks)) {
+      return 1;
+    }
+  }
+  std::cout << "Racing cooks take exactly what the stock holds" << std::endl;
+
+  std::vector<std::vector<Core::Ingredient>> lists;
+  for (auto type : TYPES) {
+    lists.push_back(toList(Core::recipeOf(type).ingredients));
+  }
+  std::cout << std::left << std::setw(8) << "cooks" << std::setw(16)
+            << "map (M/s)" << std::setw(16) << "lanes (M/s)" << "speedup"
+            << std::endl;
+  for (uint32_t cooks : cookCounts) {
+    MapStock mapStock;
+    double mapRate = reservationsPerSecond(
+        cooks, run,
+        [&](std::size_t index, const std::function<bool()> &reservation) {
+          return mapStock.consumeIngredients(lists[index], reservation);
+        },
+        [&]() { return mapStock.getStock().size(); });
+
+    Kitchen::Stock stock(std::chrono::milliseconds(0));
+    double lanesRate = reservationsPerSecond(
+        cooks, run,
+        [&](std::size_t index, const std::function<bool()> &reservation) {
+          return stock.consumeIngredients(
+              Core::recipeOf(TYPES[index]).ingredients, reservation);
+        },
+        [&]() { return stock.getStock().size(); });
+
+    std::cout << std::setw(8) << cooks << std::fixed << std::setprecision(2)
+              << std::setw(16) << mapRate / 1e6 << std::setw(16)
+              << lanesRate / 1e6 << std::setprecision(1)
+              << lanesRate / mapRate << "x" << std::endl;
+  }
+  return 0;
+}
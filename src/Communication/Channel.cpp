@@ -0,0 +1,14 @@
+#include "Communication/Channel.hpp"
+#include "Communication/InMemoryChannel.hpp"
+#include "Communication/MessageQueue.hpp"
+
+namespace Plazza::Communication {
+std::unique_ptr<Channel> Channel::open(Transport transport,
+                                       const std::string &name, bool isCreator,
+                                       int maxMessageCount) {
+  if (transport == Transport::InMemory) {
+    return std::make_unique<InMemoryChannel>(name, isCreator);
+  }
+  return std::make_unique<MessageQueue>(name, isCreator, maxMessageCount);
+}
+} // namespace Plazza::Communication
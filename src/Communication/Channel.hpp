@@ -0,0 +1,90 @@
+/**
+ * @file Channel.hpp
+ * @brief Defines the Channel interface implemented by the IPC transports.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace Plazza::Communication {
+/**
+ * @enum Transport
+ * @brief Enum representing how messages travel between reception and
+ * kitchens.
+ */
+enum class Transport {
+  MessageQueue, ///< POSIX message queues, for kitchens in other processes.
+  InMemory      ///< Queues in this process, for kitchens running as threads.
+};
+
+/**
+ * @class Channel
+ * @brief A named, one-way queue of serialized messages.
+ */
+class Channel {
+public:
+  /**
+   * @brief Virtual destructor for Channel.
+   */
+  virtual ~Channel() = default;
+
+  /**
+   * @brief Factory method to open a channel of the given transport.
+   * @param transport The transport of the channel.
+   * @param name The name of the channel.
+   * @param isCreator If true, the channel is created, otherwise an existing
+   * one is opened.
+   * @param maxMessageCount The capacity of the channel, if it is bounded.
+   * @return A unique pointer to the opened channel.
+   * @throws Exceptions::MessageException if the channel cannot be opened.
+   */
+  static std::unique_ptr<Channel> open(Transport transport,
+                                       const std::string &name, bool isCreator,
+                                       int maxMessageCount);
+
+  /**
+   * @brief Sends a message to the channel.
+   * @param message The message to send.
+   * @param priority The priority of the message.
+   * @throws Exceptions::MessageException if sending fails.
+   */
+  virtual void send(const std::string &message, unsigned int priority = 0) = 0;
+
+  /**
+   * @brief Sends a message, waiting at most the given timeout for room in
+   * the channel. Meant for channels with a single sender.
+   * @param message The message to send.
+   * @param timeout The maximum time to wait.
+   * @return True if the message was sent, false if the channel stayed full.
+   * @throws Exceptions::MessageException if sending fails.
+   */
+  virtual bool timedSend(const std::string &message,
+                         std::chrono::milliseconds timeout) = 0;
+
+  /**
+   * @brief Receives a message from the channel.
+   * @return The message, or std::nullopt if none is available.
+   * @throws Exceptions::MessageException if receiving fails.
+   */
+  virtual std::optional<std::string> receive() = 0;
+
+  /**
+   * @brief Receives a message, waiting at most the given timeout.
+   * @param timeout The maximum time to wait.
+   * @return The message, or std::nullopt if none arrived in time.
+   * @throws Exceptions::MessageException if receiving fails.
+   */
+  virtual std::optional<std::string>
+  timedReceive(std::chrono::milliseconds timeout) = 0;
+
+  /**
+   * @brief Gets a descriptor that is readable while messages are waiting.
+   * @return The descriptor, -1 if closed.
+   */
+  [[nodiscard]] virtual int getDescriptor() const = 0;
+};
+} // namespace Plazza::Communication
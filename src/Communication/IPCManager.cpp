@@ -5,26 +5,30 @@
 
 namespace Plazza::Communication {
 
-IPCManager::IPCManager(uint32_t id, bool isReception, uint32_t cooksCount)
-    : m_id(id), m_isReception(isReception), m_cooksCount(cooksCount) {
+IPCManager::IPCManager(uint32_t id, bool isReception, uint32_t cooksCount,
+                       Transport transport)
+    : m_id(id), m_isReception(isReception), m_cooksCount(cooksCount),
+      m_transport(transport) {
 
   if (m_isReception) {
     m_receptionInbox =
-        std::make_unique<MessageQueue>("reception_inbox", true, cooksCount);
+        Channel::open(m_transport, "reception_inbox", true, cooksCount);
   }
 }
 
 IPCManager::~IPCManager() { stopListening(); }
 
-void IPCManager::createKitchenChannel(uint32_t kitchenId) {
+void IPCManager::createKitchenChannel(uint32_t kitchenId, uint32_t capacity) {
   if (!m_isReception) {
     throw Exceptions::IPCException(
         "Only reception can create kitchen channels");
   }
 
   std::string queueName = "kitchen_" + std::to_string(kitchenId) + "_inbox";
-  m_kitchenQueues[kitchenId] =
-      std::make_unique<MessageQueue>(queueName, true, m_cooksCount);
+  std::unique_ptr<Channel> channel =
+      Channel::open(m_transport, queueName, true, capacity);
+  std::unique_lock<std::shared_mutex> lock(m_kitchenQueuesMutex);
+  m_kitchenQueues[kitchenId] = std::move(channel);
 }
 
 void IPCManager::removeKitchenChannel(uint32_t kitchenId) {
@@ -33,18 +37,31 @@ void IPCManager::removeKitchenChannel(uint32_t kitchenId) {
         "Only reception can remove kitchen channels");
   }
 
-  m_kitchenQueues.erase(kitchenId);
+  std::shared_ptr<Channel> channel;
+  std::unique_lock<std::shared_mutex> lock(m_kitchenQueuesMutex);
+  auto it = m_kitchenQueues.find(kitchenId);
+  if (it != m_kitchenQueues.end()) {
+    channel = std::move(it->second);
+    m_kitchenQueues.erase(it);
+  }
 }
 
-void IPCManager::sendToKitchen(uint32_t kitchenId, const Message &message) {
+bool IPCManager::sendToKitchen(uint32_t kitchenId, const Message &message,
+                               std::chrono::milliseconds timeout) {
   if (!m_isReception) {
     throw Exceptions::IPCException("Only reception can send to kitchens");
   }
 
-  auto it = m_kitchenQueues.find(kitchenId);
-  if (it != m_kitchenQueues.end()) {
-    it->second->send(message.serialize());
+  std::shared_ptr<Channel> channel;
+  {
+    std::shared_lock<std::shared_mutex> lock(m_kitchenQueuesMutex);
+    auto it = m_kitchenQueues.find(kitchenId);
+    if (it == m_kitchenQueues.end()) {
+      return true;
+    }
+    channel = it->second;
   }
+  return channel->timedSend(message.serialize(), timeout);
 }
 
 void IPCManager::broadcastToKitchens(const Message &message) {
@@ -53,6 +70,7 @@ void IPCManager::broadcastToKitchens(const Message &message) {
         "Broadcasting to kitchens is only allowed from reception");
   }
 
+  std::shared_lock<std::shared_mutex> lock(m_kitchenQueuesMutex);
   for (const auto &[kitchenId, queue] : m_kitchenQueues) {
     try {
       queue->send(message.serialize());
@@ -69,11 +87,10 @@ void IPCManager::connectToReception() {
   }
 
   std::string inboxName = "kitchen_" + std::to_string(m_id) + "_inbox";
-  m_kitchenInbox =
-      std::make_unique<MessageQueue>(inboxName, false, m_cooksCount);
+  m_kitchenInbox = Channel::open(m_transport, inboxName, false, m_cooksCount);
 
   m_receptionOutbox =
-      std::make_unique<MessageQueue>("reception_inbox", false, m_cooksCount);
+      Channel::open(m_transport, "reception_inbox", false, m_cooksCount);
   m_connected = true;
 }
 
@@ -112,8 +129,25 @@ void IPCManager::stopListening() {
   }
 }
 
+void IPCManager::processPending() {
+  Channel *inbox =
+      m_isReception ? m_receptionInbox.get() : m_kitchenInbox.get();
+
+  if (!inbox || m_listening) {
+    return;
+  }
+
+  try {
+    while (std::optional<std::string> messageData = inbox->receive()) {
+      processMessage(Message::deserialize(*messageData));
+    }
+  } catch (const std::exception &e) {
+    LOG_ERROR("Error receiving message: " + std::string(e.what()));
+  }
+}
+
 void IPCManager::listenLoop() {
-  MessageQueue *inbox =
+  Channel *inbox =
       m_isReception ? m_receptionInbox.get() : m_kitchenInbox.get();
 
   if (!inbox) {
@@ -136,6 +170,27 @@ void IPCManager::listenLoop() {
   }
 }
 
+void IPCManager::attach(Core::EventLoop &loop) {
+  Channel *inbox =
+      m_isReception ? m_receptionInbox.get() : m_kitchenInbox.get();
+
+  if (!inbox) {
+    throw Exceptions::IPCException("No inbox to attach to the event loop");
+  }
+  loop.watch(inbox->getDescriptor(), [this, inbox]() { receiveOne(*inbox); });
+}
+
+void IPCManager::receiveOne(Channel &inbox) {
+  try {
+    std::optional<std::string> messageData = inbox.receive();
+    if (messageData) {
+      processMessage(Message::deserialize(*messageData));
+    }
+  } catch (const std::exception &e) {
+    LOG_ERROR("Error receiving message: " + std::string(e.what()));
+  }
+}
+
 void IPCManager::processMessage(const Message &message) {
   auto it = m_handlers.find(message.getType());
   if (it != m_handlers.end()) {
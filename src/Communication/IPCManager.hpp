@@ -5,11 +5,14 @@
 
 #pragma once
 
+#include "Communication/Channel.hpp"
 #include "Communication/Message.hpp"
-#include "Communication/MessageQueue.hpp"
+#include "Core/EventLoop.hpp"
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -18,6 +21,8 @@ namespace Plazza::Communication {
 /**
  * @class IPCManager
  * @brief A class for managing IPC.
+ * On the reception side, kitchens may be sent to from several threads while
+ * kitchen channels are created and removed.
  */
 class IPCManager {
 public:
@@ -25,8 +30,11 @@ public:
    * @brief Constructs an IPCManager instance.
    * @param id The ID of the IPCManager.
    * @param isReception If true, this instance acts as a reception manager.
+   * @param cooksCount The number of cooks per kitchen, bounding the queues.
+   * @param transport How messages travel between reception and kitchens.
    */
-  IPCManager(uint32_t id, bool isReception = false, uint32_t cooksCount = 0);
+  IPCManager(uint32_t id, bool isReception = false, uint32_t cooksCount = 0,
+             Transport transport = Transport::MessageQueue);
 
   /**
    * @brief Destructor that stops listening.
@@ -36,9 +44,10 @@ public:
   /**
    * @brief Creates a kitchen channel.
    * @param kitchenId The ID of the kitchen.
+   * @param capacity How many messages the channel holds.
    * @throws Exceptions::IPCException if the IPCManager is not a reception.
    */
-  void createKitchenChannel(uint32_t kitchenId);
+  void createKitchenChannel(uint32_t kitchenId, uint32_t capacity);
 
   /**
    * @brief Removes a kitchen channel.
@@ -48,12 +57,18 @@ public:
   void removeKitchenChannel(uint32_t kitchenId);
 
   /**
-   * @brief Sends a message to a specific kitchen.
+   * @brief Sends a message to a specific kitchen, waiting at most the given
+   * timeout for room in its channel. The channel lock is not held while
+   * waiting, so kitchens can be added and removed meanwhile.
    * @param kitchenId The ID of the kitchen to send the message to.
    * @param message The message to send.
+   * @param timeout The maximum time to wait for room.
+   * @return False if the channel of the kitchen stayed full, true otherwise.
    * @throws Exceptions::IPCException if the IPCManager is not a reception.
+   * @throws Exceptions::MessageException if sending fails.
    */
-  void sendToKitchen(uint32_t kitchenId, const Message &message);
+  bool sendToKitchen(uint32_t kitchenId, const Message &message,
+                     std::chrono::milliseconds timeout);
 
   /**
    * @brief Broadcasts a message to all kitchens.
@@ -96,6 +111,22 @@ public:
    */
   void stopListening();
 
+  /**
+   * @brief Processes the messages left in the inbox on the calling thread.
+   * Used once listening stopped and the senders exited, so that nothing they
+   * sent is lost.
+   */
+  void processPending();
+
+  /**
+   * @brief Dispatches incoming messages from an event loop instead of a
+   * listener thread.
+   * Handlers then run on the thread running the loop.
+   * @param loop The event loop watching the inbox.
+   * @throws Exceptions::IPCException if there is no inbox to watch.
+   */
+  void attach(Core::EventLoop &loop);
+
   /**
    * @brief Checks if the IPCManager is connected to the reception.
    * @return True if connected, false otherwise.
@@ -109,6 +140,12 @@ private:
    */
   void listenLoop();
 
+  /**
+   * @brief Receives and processes one message from an inbox.
+   * @param inbox The inbox to read from.
+   */
+  void receiveOne(Channel &inbox);
+
   /**
    * @brief Processes a received message.
    * @param message The message to process.
@@ -129,16 +166,18 @@ private:
   std::atomic<bool> m_connected{false};
   std::atomic<bool> m_listening{false};
 
-  std::unordered_map<uint32_t, std::unique_ptr<MessageQueue>> m_kitchenQueues;
-  std::unique_ptr<MessageQueue> m_kitchenInbox;
+  std::unordered_map<uint32_t, std::shared_ptr<Channel>> m_kitchenQueues;
+  mutable std::shared_mutex m_kitchenQueuesMutex;
+  std::unique_ptr<Channel> m_kitchenInbox;
 
-  std::unique_ptr<MessageQueue> m_receptionInbox;
-  std::unique_ptr<MessageQueue> m_receptionOutbox;
+  std::unique_ptr<Channel> m_receptionInbox;
+  std::unique_ptr<Channel> m_receptionOutbox;
 
   std::unordered_map<Message::MessageType, std::function<void(const Message &)>>
       m_handlers;
   std::thread m_listenerThread;
 
   uint32_t m_cooksCount;
+  Transport m_transport;
 };
 } // namespace Plazza::Communication
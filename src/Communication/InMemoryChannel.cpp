@@ -0,0 +1,110 @@
+#include "Communication/InMemoryChannel.hpp"
+#include "Exceptions/MessageException.hpp"
+#include <cerrno>
+#include <cstring>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace Plazza::Communication {
+InMemoryChannel::State::State() {
+  eventFd = eventfd(0, EFD_SEMAPHORE | EFD_NONBLOCK | EFD_CLOEXEC);
+  if (eventFd == -1) {
+    throw Exceptions::MessageException("Failed to create channel eventfd: " +
+                                       std::string(std::strerror(errno)));
+  }
+}
+
+InMemoryChannel::State::~State() { ::close(eventFd); }
+
+InMemoryChannel::InMemoryChannel(const std::string &name, bool isCreator)
+    : m_name(name), m_isCreator(isCreator) {
+  std::lock_guard<std::mutex> lock(registryMutex());
+
+  if (m_isCreator) {
+    m_state = std::make_shared<State>();
+    registry()[m_name] = m_state;
+    return;
+  }
+
+  auto it = registry().find(m_name);
+  if (it == registry().end()) {
+    throw Exceptions::MessageException("Failed to open channel: " + m_name +
+                                       " - No such channel");
+  }
+  m_state = it->second;
+}
+
+InMemoryChannel::~InMemoryChannel() {
+  if (!m_isCreator) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(registryMutex());
+  auto it = registry().find(m_name);
+  if (it != registry().end() && it->second == m_state) {
+    registry().erase(it);
+  }
+}
+
+void InMemoryChannel::send(const std::string &message,
+                           [[maybe_unused]] unsigned int priority) {
+  {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->messages.push_back(message);
+  }
+  m_state->condition.notify_one();
+
+  uint64_t one = 1;
+  [[maybe_unused]] ssize_t written =
+      ::write(m_state->eventFd, &one, sizeof(one));
+}
+
+bool InMemoryChannel::timedSend(
+    const std::string &message,
+    [[maybe_unused]] std::chrono::milliseconds timeout) {
+  send(message);
+  return true;
+}
+
+std::optional<std::string> InMemoryChannel::receive() {
+  std::lock_guard<std::mutex> lock(m_state->mutex);
+  if (m_state->messages.empty()) {
+    return std::nullopt;
+  }
+  return popLocked();
+}
+
+std::optional<std::string>
+InMemoryChannel::timedReceive(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(m_state->mutex);
+  if (!m_state->condition.wait_for(lock, timeout, [this]() {
+        return !m_state->messages.empty();
+      })) {
+    return std::nullopt;
+  }
+  return popLocked();
+}
+
+int InMemoryChannel::getDescriptor() const { return m_state->eventFd; }
+
+std::unordered_map<std::string, std::shared_ptr<InMemoryChannel::State>> &
+InMemoryChannel::registry() {
+  static std::unordered_map<std::string, std::shared_ptr<State>> channels;
+  return channels;
+}
+
+std::mutex &InMemoryChannel::registryMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::string InMemoryChannel::popLocked() {
+  std::string message = std::move(m_state->messages.front());
+  m_state->messages.pop_front();
+
+  uint64_t count = 0;
+  [[maybe_unused]] ssize_t bytesRead =
+      ::read(m_state->eventFd, &count, sizeof(count));
+  return message;
+}
+} // namespace Plazza::Communication
@@ -0,0 +1,91 @@
+/**
+ * @file InMemoryChannel.hpp
+ * @brief Defines the InMemoryChannel class for messages between threads of
+ * the same process.
+ */
+
+#pragma once
+
+#include "Communication/Channel.hpp"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Plazza::Communication {
+/**
+ * @class InMemoryChannel
+ * @brief A channel kept in this process, looked up by name like a message
+ * queue.
+ * Messages are moved through a mutex-protected deque, with an eventfd
+ * counting them so the channel can be watched by an event loop. Unlike a
+ * message queue it is unbounded, so senders never block.
+ */
+class InMemoryChannel : public Channel {
+public:
+  /**
+   * @brief Constructs an InMemoryChannel instance.
+   * @param name The name of the channel.
+   * @param isCreator If true, the channel is created, replacing any channel
+   * with the same name, otherwise the existing one is opened.
+   * @throws Exceptions::MessageException if the channel does not exist or
+   * its eventfd cannot be created.
+   */
+  InMemoryChannel(const std::string &name, bool isCreator);
+
+  /**
+   * @brief Destructor that removes the channel name if this is the creator.
+   */
+  ~InMemoryChannel() override;
+
+  InMemoryChannel(const InMemoryChannel &) = delete;
+  InMemoryChannel &operator=(const InMemoryChannel &) = delete;
+
+  void send(const std::string &message, unsigned int priority = 0) override;
+  bool timedSend(const std::string &message,
+                 std::chrono::milliseconds timeout) override;
+  std::optional<std::string> receive() override;
+  std::optional<std::string>
+  timedReceive(std::chrono::milliseconds timeout) override;
+  [[nodiscard]] int getDescriptor() const override;
+
+private:
+  /**
+   * @struct State
+   * @brief The queue shared by every handle on a channel.
+   */
+  struct State {
+    State();
+    ~State();
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::string> messages;
+    int eventFd;
+  };
+
+  /**
+   * @brief Gets the channels of this process by name.
+   * Must be accessed with registryMutex() held.
+   * @return The channel registry.
+   */
+  static std::unordered_map<std::string, std::shared_ptr<State>> &registry();
+
+  /**
+   * @brief Gets the mutex guarding the channel registry.
+   * @return The registry mutex.
+   */
+  static std::mutex &registryMutex();
+
+  /**
+   * @brief Pops the oldest message, the state mutex being held.
+   * @return The message.
+   */
+  std::string popLocked();
+
+  std::string m_name;
+  bool m_isCreator;
+  std::shared_ptr<State> m_state;
+};
+} // namespace Plazza::Communication
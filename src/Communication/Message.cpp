@@ -1,5 +1,6 @@
 #include "Communication/Message.hpp"
 #include "Exceptions/MessageException.hpp"
+#include <chrono>
 #include <cstring>
 #include <fcntl.h>
 #include <sstream>
@@ -12,6 +13,16 @@ Message::Message(MessageType type, uint32_t senderId, uint32_t timestamp,
     : m_type(type), m_senderId(senderId), m_timestamp(timestamp),
       m_payload(std::move(payload)) {}
 
+Message Message::create(MessageType type, uint32_t senderId,
+                        std::string payload) {
+  return Message(type, senderId,
+                 static_cast<uint32_t>(
+                     std::chrono::duration_cast<std::chrono::seconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count()),
+                 std::move(payload));
+}
+
 std::string Message::serialize() const {
   std::ostringstream oss;
   oss << static_cast<int>(m_type) << "|" << m_senderId << "|" << m_timestamp
@@ -23,7 +23,13 @@ public:
     STATUS_REQUEST = 3,
     STATUS_RESPONSE = 4,
     SHUTDOWN = 5,
-    HEARTBEAT = 6
+    HEARTBEAT = 6,
+    ORDER_HANDBACK = 7,
+    WORK_REQUEST = 8,
+    RECALL_ORDERS = 9,
+    DRAIN = 10,
+    DRAINED = 11,
+    RESIZE_COOKS = 12
   };
 
   /**
@@ -36,6 +42,16 @@ public:
   Message(MessageType type, uint32_t senderId, uint32_t timestamp,
           std::string payload);
 
+  /**
+   * @brief Creates a message stamped with the current time.
+   * @param type The type of the message.
+   * @param senderId The ID of the sender.
+   * @param payload The payload of the message.
+   * @return The created message.
+   */
+  static Message create(MessageType type, uint32_t senderId,
+                        std::string payload = "");
+
   /**
    * @brief Serializes the message to a string format.
    */
@@ -1,7 +1,10 @@
 #include "Communication/MessageQueue.hpp"
 #include "Exceptions/MessageException.hpp"
+#include <algorithm>
 #include <cstring>
 #include <fcntl.h>
+#include <fstream>
+#include <poll.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -12,7 +15,7 @@ MessageQueue::MessageQueue(const std::string &queueName, bool isCreator,
       m_isOpen(false) {
   struct mq_attr attr = {};
   attr.mq_flags = 0;
-  attr.mq_maxmsg = maxMessageCount;
+  attr.mq_maxmsg = std::min(maxMessageCount, maxDepth());
   attr.mq_msgsize = MAX_MESSAGE_SIZE;
   attr.mq_curmsgs = 0;
 
@@ -33,6 +36,18 @@ MessageQueue::MessageQueue(const std::string &queueName, bool isCreator,
 
 MessageQueue::~MessageQueue() { close(); }
 
+int MessageQueue::maxDepth() {
+  static const int depth = []() {
+    int limit = 10;
+    std::ifstream file("/proc/sys/fs/mqueue/msg_max");
+    if (!(file >> limit) || limit <= 0) {
+      limit = 10;
+    }
+    return limit;
+  }();
+  return depth;
+}
+
 MessageQueue::MessageQueue(MessageQueue &&other) noexcept
     : m_name(std::move(other.m_name)), m_descriptor(other.m_descriptor),
       m_isCreator(other.m_isCreator), m_isOpen(other.m_isOpen) {
@@ -68,6 +83,39 @@ void MessageQueue::send(const std::string &message, unsigned int priority) {
   }
 }
 
+bool MessageQueue::timedSend(const std::string &message,
+                             std::chrono::milliseconds timeout) {
+  if (!m_isOpen || m_descriptor == -1) {
+    throw Exceptions::MessageException("Message queue is not open");
+  }
+
+  struct pollfd pollDescriptor = {};
+  pollDescriptor.fd = m_descriptor;
+  pollDescriptor.events = POLLOUT;
+
+  int ready = ::poll(&pollDescriptor, 1, static_cast<int>(timeout.count()));
+  if (ready == -1 && errno != EINTR) {
+    throw Exceptions::MessageException("Failed to wait for room: " +
+                                       std::string(std::strerror(errno)));
+  }
+  if (ready <= 0) {
+    return false;
+  }
+
+  if (message.size() >= MAX_MESSAGE_SIZE) {
+    throw Exceptions::MessageException("Message too large");
+  }
+
+  if (mq_send(m_descriptor, message.c_str(), message.size(), 0) == -1) {
+    if (errno == EAGAIN) {
+      return false;
+    }
+    throw Exceptions::MessageException("Failed to send message: " +
+                                       std::string(std::strerror(errno)));
+  }
+  return true;
+}
+
 std::optional<std::string> MessageQueue::receive() {
   if (!m_isOpen || m_descriptor == -1) {
     throw Exceptions::MessageException("Message queue is not open");
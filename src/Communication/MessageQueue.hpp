@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "Communication/Channel.hpp"
 #include <chrono>
 #include <mqueue.h>
 #include <optional>
@@ -17,13 +18,14 @@ namespace Plazza::Communication {
  * @brief A class for managing a POSIX message queue for inter-process
  * communication.
  */
-class MessageQueue {
+class MessageQueue : public Channel {
 public:
   /**
    * @brief Constructs a MessageQueue instance.
    * @param queueName The name of the message queue.
    * @param isCreator If true, the queue will be created, otherwise, it will be
    * opened if it already exists.
+   * @param maxMessageCount Capacity of a created queue, capped at maxDepth().
    */
   MessageQueue(const std::string &queueName, bool isCreator = false,
                int maxMessageCount = 10);
@@ -31,7 +33,7 @@ public:
   /**
    * @brief Destructor that closes the message queue.
    */
-  ~MessageQueue();
+  ~MessageQueue() override;
 
   MessageQueue(const MessageQueue &) = delete;
   MessageQueue &operator=(const MessageQueue &) = delete;
@@ -55,14 +57,25 @@ public:
    * @param priority The priority of the message.
    * @throws Exceptions::MessageException if sending fails.
    */
-  void send(const std::string &message, unsigned int priority = 0);
+  void send(const std::string &message, unsigned int priority = 0) override;
+
+  /**
+   * @brief Sends a message, polling the queue descriptor for room while the
+   * queue is full, for at most the given timeout.
+   * @param message The message to send.
+   * @param timeout The maximum time to wait for room.
+   * @return True if the message was sent, false if the queue stayed full.
+   * @throws Exceptions::MessageException if sending fails.
+   */
+  bool timedSend(const std::string &message,
+                 std::chrono::milliseconds timeout) override;
 
   /**
    * @brief Receives a message from the message queue.
    * @return The received message, or std::nullopt if no message is available.
    * @throws Exceptions::MessageException if receiving fails.
    */
-  std::optional<std::string> receive();
+  std::optional<std::string> receive() override;
 
   /**
    * @brief Receives a message from the message queue with a timeout.
@@ -71,7 +84,8 @@ public:
    * within the timeout.
    * @throws Exceptions::MessageException if receiving fails.
    */
-  std::optional<std::string> timedReceive(std::chrono::milliseconds timeout);
+  std::optional<std::string>
+  timedReceive(std::chrono::milliseconds timeout) override;
 
   /**
    * @brief Checks if the message queue is valid.
@@ -79,6 +93,19 @@ public:
    */
   [[nodiscard]] bool isValid() const { return m_descriptor != -1; }
 
+  /**
+   * @brief Gets the descriptor of the message queue.
+   * On Linux it can be watched with epoll for readability.
+   * @return The message queue descriptor, -1 if closed.
+   */
+  [[nodiscard]] int getDescriptor() const override { return m_descriptor; }
+
+  /**
+   * @brief Gets the largest capacity the system allows for a queue.
+   * @return The fs.mqueue.msg_max limit, or 10 if it cannot be read.
+   */
+  static int maxDepth();
+
   /**
    * @brief Closes the message queue.
    * @throws Exceptions::MessageException if closing fails.
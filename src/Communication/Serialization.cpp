@@ -9,6 +9,7 @@ Core::OpaqueObject PizzaOrder::pack() const {
   object.pack(static_cast<uint32_t>(size));
   object.pack(quantity);
   object.pack(orderId);
+  object.pack(deadline);
 
   return object;
 }
@@ -22,6 +23,7 @@ void PizzaOrder::unpack(const Core::OpaqueObject &object) {
   mutableObject.unpack(sizeValue);
   mutableObject.unpack(quantity);
   mutableObject.unpack(orderId);
+  mutableObject.unpack(deadline);
 
   type = static_cast<Core::PizzaType>(typeValue);
   size = static_cast<Core::PizzaSize>(sizeValue);
@@ -77,6 +79,7 @@ Core::OpaqueObject PizzaCompletion::pack() const {
       std::chrono::duration_cast<std::chrono::nanoseconds>(completionTimeNs)
           .count();
   object.pack(static_cast<uint64_t>(totalNanoseconds));
+  object.pack(deadline);
 
   return object;
 }
@@ -94,5 +97,6 @@ void PizzaCompletion::unpack(const Core::OpaqueObject &object) {
   mutableObject.unpack(nanosecondsCount);
   completionTime = std::chrono::steady_clock::time_point(
       std::chrono::nanoseconds(nanosecondsCount));
+  mutableObject.unpack(deadline);
 }
 } // namespace Plazza::Communication
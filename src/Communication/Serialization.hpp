@@ -21,7 +21,8 @@ struct PizzaOrder {
   Core::PizzaType type;
   Core::PizzaSize size;
   uint32_t quantity;
-  uint32_t orderId;
+  uint64_t orderId;
+  uint64_t deadline = 0; ///< Steady clock nanoseconds, 0 if none.
 
   Core::OpaqueObject pack() const;
   void unpack(const Core::OpaqueObject &object);
@@ -49,6 +50,7 @@ struct KitchenStatus {
 struct PizzaCompletion {
   Core::PizzaPacket pizza;
   std::chrono::steady_clock::time_point completionTime;
+  uint64_t deadline = 0; ///< Deadline of the order, 0 if none.
 
   Core::OpaqueObject pack() const;
   void unpack(const Core::OpaqueObject &object);
@@ -0,0 +1,165 @@
+#include "Communication/SharedOrderTable.hpp"
+#include "Exceptions/IPCException.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Plazza::Communication {
+SharedOrderTable::SharedOrderTable(const std::string &name, bool isCreator)
+    : m_name("/" + name), m_isCreator(isCreator) {
+  int descriptor = -1;
+
+  if (m_isCreator) {
+    shm_unlink(m_name.c_str());
+    descriptor = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (descriptor != -1 && ftruncate(descriptor, sizeof(Layout)) == -1) {
+      ::close(descriptor);
+      shm_unlink(m_name.c_str());
+      descriptor = -1;
+    }
+  } else {
+    descriptor = shm_open(m_name.c_str(), O_RDWR, 0);
+  }
+
+  if (descriptor == -1) {
+    throw Exceptions::IPCException("Failed to open order table: " + m_name +
+                                   " - " + std::strerror(errno));
+  }
+
+  void *address = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE,
+                       MAP_SHARED, descriptor, 0);
+  ::close(descriptor);
+
+  if (address == MAP_FAILED) {
+    if (m_isCreator) {
+      shm_unlink(m_name.c_str());
+    }
+    throw Exceptions::IPCException("Failed to map order table: " + m_name +
+                                   " - " + std::strerror(errno));
+  }
+
+  m_layout = m_isCreator ? new (address) Layout()
+                         : static_cast<Layout *>(address);
+}
+
+SharedOrderTable::~SharedOrderTable() {
+  if (m_layout) {
+    munmap(m_layout, sizeof(Layout));
+    m_layout = nullptr;
+  }
+  if (m_isCreator) {
+    shm_unlink(m_name.c_str());
+  }
+}
+
+bool SharedOrderTable::publish(const PizzaOrder &order) {
+  uint32_t start =
+      m_layout->publishCursor.fetch_add(1, std::memory_order_relaxed);
+
+  for (uint32_t i = 0; i < CAPACITY; ++i) {
+    Slot &slot = m_layout->slots[(start + i) % CAPACITY];
+    uint64_t control = slot.control.load(std::memory_order_acquire);
+    if (stateOf(control) != SlotState::Empty) {
+      continue;
+    }
+
+    uint32_t generation = generationOf(control) + 1;
+    if (!slot.control.compare_exchange_strong(
+            control, makeControl(SlotState::Writing, 0, generation),
+            std::memory_order_acq_rel)) {
+      continue;
+    }
+
+    slot.type.store(static_cast<uint32_t>(order.type),
+                    std::memory_order_relaxed);
+    slot.size.store(static_cast<uint32_t>(order.size),
+                    std::memory_order_relaxed);
+    slot.quantity.store(order.quantity, std::memory_order_relaxed);
+    slot.orderId.store(order.orderId, std::memory_order_relaxed);
+    slot.deadline.store(order.deadline, std::memory_order_relaxed);
+    m_layout->occupied.fetch_add(1, std::memory_order_relaxed);
+    slot.control.store(makeControl(SlotState::Ready, 0, generation),
+                       std::memory_order_release);
+    return true;
+  }
+  return false;
+}
+
+std::optional<ClaimedOrder> SharedOrderTable::claim(
+    uint32_t kitchenId,
+    const std::function<bool(const PizzaOrder &)> &canCook) {
+  for (uint32_t i = 0; i < CAPACITY; ++i) {
+    uint32_t index = (m_claimCursor + i) % CAPACITY;
+    Slot &slot = m_layout->slots[index];
+    uint64_t control = slot.control.load(std::memory_order_acquire);
+    if (stateOf(control) != SlotState::Ready) {
+      continue;
+    }
+
+    PizzaOrder order;
+    order.type = static_cast<Core::PizzaType>(
+        slot.type.load(std::memory_order_relaxed));
+    order.size = static_cast<Core::PizzaSize>(
+        slot.size.load(std::memory_order_relaxed));
+    order.quantity = slot.quantity.load(std::memory_order_relaxed);
+    order.orderId = slot.orderId.load(std::memory_order_relaxed);
+    order.deadline = slot.deadline.load(std::memory_order_relaxed);
+
+    if (!canCook(order)) {
+      continue;
+    }
+
+    uint64_t ticket =
+        makeControl(SlotState::Claimed, kitchenId, generationOf(control));
+    if (slot.control.compare_exchange_strong(control, ticket,
+                                             std::memory_order_acq_rel)) {
+      m_claimCursor = index + 1;
+      return ClaimedOrder{index, ticket, order};
+    }
+  }
+  return std::nullopt;
+}
+
+bool SharedOrderTable::release(uint32_t slot, uint64_t ticket) {
+  Slot &entry = m_layout->slots[slot % CAPACITY];
+  return entry.control.compare_exchange_strong(
+      ticket, makeControl(SlotState::Ready, 0, generationOf(ticket)),
+      std::memory_order_acq_rel);
+}
+
+bool SharedOrderTable::complete(uint32_t slot, uint64_t ticket) {
+  Slot &entry = m_layout->slots[slot % CAPACITY];
+  if (!entry.control.compare_exchange_strong(
+          ticket, makeControl(SlotState::Empty, 0, generationOf(ticket)),
+          std::memory_order_acq_rel)) {
+    return false;
+  }
+  m_layout->occupied.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+uint32_t SharedOrderTable::reclaim(uint32_t kitchenId) {
+  uint32_t reclaimed = 0;
+
+  for (Slot &slot : m_layout->slots) {
+    uint64_t control = slot.control.load(std::memory_order_acquire);
+    if (stateOf(control) != SlotState::Claimed ||
+        ownerOf(control) != (kitchenId & 0xFFFFFF)) {
+      continue;
+    }
+    if (slot.control.compare_exchange_strong(
+            control, makeControl(SlotState::Ready, 0, generationOf(control)),
+            std::memory_order_acq_rel)) {
+      ++reclaimed;
+    }
+  }
+  return reclaimed;
+}
+
+uint32_t SharedOrderTable::occupied() const {
+  return m_layout->occupied.load(std::memory_order_relaxed);
+}
+} // namespace Plazza::Communication
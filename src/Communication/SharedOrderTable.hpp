@@ -0,0 +1,161 @@
+/**
+ * @file SharedOrderTable.hpp
+ * @brief Defines the SharedOrderTable class for sharing pizza orders between
+ * processes.
+ */
+
+#pragma once
+
+#include "Communication/Serialization.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace Plazza::Communication {
+/**
+ * @struct ClaimedOrder
+ * @brief An order claimed from the shared order table.
+ */
+struct ClaimedOrder {
+  uint32_t slot;
+  uint64_t ticket;
+  PizzaOrder order;
+};
+
+/**
+ * @class SharedOrderTable
+ * @brief A fixed-size order table in POSIX shared memory.
+ *
+ * The reception publishes orders into free slots and kitchens claim them with
+ * a compare-and-swap on the slot control word. A claimed slot stays owned by
+ * the kitchen until the pizza is completed, so orders claimed by a kitchen
+ * that died can be put back in the table.
+ */
+class SharedOrderTable {
+public:
+  static constexpr uint32_t CAPACITY = 1024;
+  static constexpr uint32_t NO_SLOT = UINT32_MAX;
+  static constexpr const char *DEFAULT_NAME = "order_table";
+
+  /**
+   * @brief Constructs a SharedOrderTable instance.
+   * @param name The name of the shared memory object.
+   * @param isCreator If true, the table will be created, otherwise, it will be
+   * opened if it already exists.
+   * @throws Exceptions::IPCException if the shared memory cannot be mapped.
+   */
+  SharedOrderTable(const std::string &name, bool isCreator);
+
+  /**
+   * @brief Destructor that unmaps the table and removes it if owned.
+   */
+  ~SharedOrderTable();
+
+  SharedOrderTable(const SharedOrderTable &) = delete;
+  SharedOrderTable &operator=(const SharedOrderTable &) = delete;
+
+  /**
+   * @brief Publishes an order into a free slot.
+   * @param order The order to publish.
+   * @return True if the order was published, false if the table is full.
+   */
+  [[nodiscard]] bool publish(const PizzaOrder &order);
+
+  /**
+   * @brief Claims a ready order for a kitchen.
+   * @param kitchenId The ID of the claiming kitchen.
+   * @param canCook Predicate telling whether the kitchen can cook an order.
+   * Orders it rejects are left in the table.
+   * @return The claimed order, or std::nullopt if none was claimed.
+   */
+  std::optional<ClaimedOrder>
+  claim(uint32_t kitchenId,
+        const std::function<bool(const PizzaOrder &)> &canCook);
+
+  /**
+   * @brief Puts a claimed order back in the table.
+   * @param slot The slot of the claimed order.
+   * @param ticket The ticket returned with the claim.
+   * @return True if the claim was still held, false otherwise.
+   */
+  bool release(uint32_t slot, uint64_t ticket);
+
+  /**
+   * @brief Frees the slot of a completed order.
+   * @param slot The slot of the claimed order.
+   * @param ticket The ticket returned with the claim.
+   * @return True if the claim was still held, false if it was reclaimed in
+   * the meantime.
+   */
+  bool complete(uint32_t slot, uint64_t ticket);
+
+  /**
+   * @brief Puts back every order claimed by a kitchen.
+   * @param kitchenId The ID of the kitchen whose claims are released.
+   * @return The number of orders put back.
+   */
+  uint32_t reclaim(uint32_t kitchenId);
+
+  /**
+   * @brief Gets the number of published orders that are not completed.
+   * @return The number of ready and claimed orders.
+   */
+  [[nodiscard]] uint32_t occupied() const;
+
+private:
+  enum class SlotState : uint8_t { Empty, Writing, Ready, Claimed };
+
+  /**
+   * @struct Slot
+   * @brief A table entry. The control word packs the slot state, the owning
+   * kitchen and a generation counter bumped on every publication.
+   */
+  struct Slot {
+    std::atomic<uint64_t> control;
+    std::atomic<uint32_t> type;
+    std::atomic<uint32_t> size;
+    std::atomic<uint32_t> quantity;
+    std::atomic<uint64_t> orderId;
+    std::atomic<uint64_t> deadline;
+  };
+
+  /**
+   * @struct Layout
+   * @brief The shared memory layout of the table.
+   */
+  struct Layout {
+    std::atomic<uint32_t> publishCursor;
+    std::atomic<uint32_t> occupied;
+    Slot slots[CAPACITY];
+  };
+
+  static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                "Shared table requires lock-free 64-bit atomics");
+
+  static constexpr uint64_t makeControl(SlotState state, uint32_t owner,
+                                        uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) |
+           (static_cast<uint64_t>(owner & 0xFFFFFF) << 8) |
+           static_cast<uint64_t>(state);
+  }
+
+  static constexpr SlotState stateOf(uint64_t control) {
+    return static_cast<SlotState>(control & 0xFF);
+  }
+
+  static constexpr uint32_t ownerOf(uint64_t control) {
+    return static_cast<uint32_t>((control >> 8) & 0xFFFFFF);
+  }
+
+  static constexpr uint32_t generationOf(uint64_t control) {
+    return static_cast<uint32_t>(control >> 32);
+  }
+
+  std::string m_name;
+  bool m_isCreator;
+  Layout *m_layout = nullptr;
+  uint32_t m_claimCursor = 0;
+};
+} // namespace Plazza::Communication
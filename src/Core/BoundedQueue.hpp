@@ -0,0 +1,110 @@
+/**
+ * @file BoundedQueue.hpp
+ * @brief Defines the BoundedQueue class, a thread-safe queue with a capacity.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace Plazza::Core {
+/**
+ * @class BoundedQueue
+ * @brief A thread-safe queue holding at most a fixed number of items.
+ * Producers block while it is full, which slows them down to the pace of the
+ * consumers, unless they only try to push. Closing the queue wakes everyone:
+ * producers give up, consumers empty what is left.
+ * @tparam T The type of items stored in the queue.
+ */
+template <typename T> class BoundedQueue {
+public:
+  /**
+   * @brief Constructs a BoundedQueue instance.
+   * @param capacity The maximum number of items, at least one.
+   */
+  explicit BoundedQueue(std::size_t capacity)
+      : m_capacity(capacity > 0 ? capacity : 1) {}
+
+  /**
+   * @brief Pushes an item, blocking while the queue is full.
+   * @param item The item to push.
+   * @return True if the item was pushed, false if the queue is closed.
+   */
+  bool push(T item) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_notFull.wait(
+        lock, [this]() { return m_closed || m_queue.size() < m_capacity; });
+    if (m_closed) {
+      return false;
+    }
+    m_queue.push_back(std::move(item));
+    m_notEmpty.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Pushes an item if there is room, without blocking.
+   * @param item The item to push.
+   * @return True if the item was pushed, false if the queue is full or
+   * closed.
+   */
+  bool tryPush(T item) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_closed || m_queue.size() >= m_capacity) {
+      return false;
+    }
+    m_queue.push_back(std::move(item));
+    m_notEmpty.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Pops an item, blocking while the queue is empty and open.
+   * @return The popped item, or std::nullopt once the queue is closed and
+   * empty.
+   */
+  std::optional<T> pop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_notEmpty.wait(lock, [this]() { return m_closed || !m_queue.empty(); });
+    if (m_queue.empty()) {
+      return std::nullopt;
+    }
+    T result = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_notFull.notify_one();
+    return result;
+  }
+
+  /**
+   * @brief Closes the queue. Items already in it can still be popped.
+   */
+  void close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closed = true;
+    m_notEmpty.notify_all();
+    m_notFull.notify_all();
+  }
+
+  /**
+   * @brief Gets the current size of the queue.
+   * @return The number of items in the queue.
+   */
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::condition_variable m_notEmpty;
+  std::condition_variable m_notFull;
+  std::deque<T> m_queue;
+  std::size_t m_capacity;
+  bool m_closed = false;
+};
+
+} // namespace Plazza::Core
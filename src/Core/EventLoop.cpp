@@ -0,0 +1,172 @@
+/**
+ * @file EventLoop.cpp
+ * @brief Implements the EventLoop class.
+ */
+
+#include "Core/EventLoop.hpp"
+#include "Exceptions/ThreadException.hpp"
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace Plazza::Core {
+namespace {
+timespec toTimespec(std::chrono::nanoseconds duration) {
+  timespec spec{};
+  spec.tv_sec = static_cast<time_t>(duration.count() / 1000000000);
+  spec.tv_nsec = static_cast<long>(duration.count() % 1000000000);
+  return spec;
+}
+
+void addToEpoll(int epollFd, int fd) {
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1) {
+    throw Exceptions::ThreadException("Failed to watch descriptor: " +
+                                      std::string(std::strerror(errno)));
+  }
+}
+} // namespace
+
+EventLoop::EventLoop() {
+  m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (m_epollFd == -1) {
+    throw Exceptions::ThreadException("Failed to create epoll instance: " +
+                                      std::string(std::strerror(errno)));
+  }
+
+  m_wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (m_wakeupFd == -1) {
+    ::close(m_epollFd);
+    throw Exceptions::ThreadException("Failed to create eventfd: " +
+                                      std::string(std::strerror(errno)));
+  }
+  addToEpoll(m_epollFd, m_wakeupFd);
+}
+
+EventLoop::~EventLoop() {
+  for (const auto &[fd, callback] : m_timers) {
+    ::close(fd);
+  }
+  ::close(m_wakeupFd);
+  ::close(m_epollFd);
+}
+
+void EventLoop::watch(int fd, Callback onReadable) {
+  addToEpoll(m_epollFd, fd);
+  m_readers[fd] = std::make_shared<Callback>(std::move(onReadable));
+}
+
+void EventLoop::unwatch(int fd) {
+  if (m_readers.erase(fd) > 0) {
+    epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  }
+}
+
+int EventLoop::createTimer(Callback onExpired) {
+  int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (timer == -1) {
+    throw Exceptions::ThreadException("Failed to create timer: " +
+                                      std::string(std::strerror(errno)));
+  }
+
+  try {
+    addToEpoll(m_epollFd, timer);
+  } catch (...) {
+    ::close(timer);
+    throw;
+  }
+  m_timers[timer] = std::move(onExpired);
+  return timer;
+}
+
+void EventLoop::setTimer(int timer,
+                         std::chrono::steady_clock::time_point deadline,
+                         std::chrono::nanoseconds interval) {
+  itimerspec spec{};
+  spec.it_value = toTimespec(deadline.time_since_epoch());
+  spec.it_interval = toTimespec(interval);
+  if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+    spec.it_value.tv_nsec = 1;
+  }
+  timerfd_settime(timer, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+void EventLoop::cancelTimer(int timer) {
+  itimerspec spec{};
+  timerfd_settime(timer, 0, &spec, nullptr);
+}
+
+void EventLoop::post(Callback callback) {
+  {
+    std::lock_guard<std::mutex> lock(m_postedMutex);
+    m_posted.push_back(std::move(callback));
+  }
+  uint64_t one = 1;
+  [[maybe_unused]] ssize_t written = ::write(m_wakeupFd, &one, sizeof(one));
+}
+
+void EventLoop::run() {
+  constexpr int MAX_EVENTS = 16;
+  epoll_event events[MAX_EVENTS];
+
+  while (!m_stopRequested) {
+    int ready = epoll_wait(m_epollFd, events, MAX_EVENTS, -1);
+    if (ready == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw Exceptions::ThreadException("Failed to wait for events: " +
+                                        std::string(std::strerror(errno)));
+    }
+
+    for (int i = 0; i < ready && !m_stopRequested; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == m_wakeupFd) {
+        runPosted();
+        continue;
+      }
+
+      auto timer = m_timers.find(fd);
+      if (timer != m_timers.end()) {
+        uint64_t expirations = 0;
+        if (::read(fd, &expirations, sizeof(expirations)) > 0) {
+          timer->second();
+        }
+        continue;
+      }
+
+      auto reader = m_readers.find(fd);
+      if (reader != m_readers.end()) {
+        std::shared_ptr<Callback> onReadable = reader->second;
+        (*onReadable)();
+      }
+    }
+  }
+}
+
+void EventLoop::stop() {
+  m_stopRequested = true;
+  uint64_t one = 1;
+  [[maybe_unused]] ssize_t written = ::write(m_wakeupFd, &one, sizeof(one));
+}
+
+void EventLoop::runPosted() {
+  uint64_t count = 0;
+  [[maybe_unused]] ssize_t bytesRead =
+      ::read(m_wakeupFd, &count, sizeof(count));
+
+  std::vector<Callback> posted;
+  {
+    std::lock_guard<std::mutex> lock(m_postedMutex);
+    posted.swap(m_posted);
+  }
+  for (auto &callback : posted) {
+    callback();
+  }
+}
+} // namespace Plazza::Core
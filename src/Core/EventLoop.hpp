@@ -0,0 +1,118 @@
+/**
+ * @file EventLoop.hpp
+ * @brief Defines the EventLoop class, a single-threaded epoll reactor.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Plazza::Core {
+/**
+ * @class EventLoop
+ * @brief Runs callbacks when file descriptors become readable, when timers
+ * expire, or when other threads post work, all on the thread calling run().
+ * Timers are timerfds on CLOCK_MONOTONIC, the clock behind steady_clock, and
+ * posted work wakes the loop through an eventfd.
+ */
+class EventLoop {
+public:
+  using Callback = std::function<void()>;
+
+  /**
+   * @brief Constructs an EventLoop instance.
+   * @throws Exceptions::ThreadException if epoll or the eventfd cannot be
+   * created.
+   */
+  EventLoop();
+
+  /**
+   * @brief Destructor that closes the loop and its timers.
+   */
+  ~EventLoop();
+
+  EventLoop(const EventLoop &) = delete;
+  EventLoop &operator=(const EventLoop &) = delete;
+
+  /**
+   * @brief Calls a callback whenever a file descriptor is readable.
+   * @param fd The file descriptor to watch. The loop does not own it.
+   * @param onReadable The callback, which must consume what it reads.
+   * @throws Exceptions::ThreadException if the descriptor cannot be watched.
+   */
+  void watch(int fd, Callback onReadable);
+
+  /**
+   * @brief Stops watching a file descriptor.
+   * It may be called from the descriptor's own callback. Descriptors that
+   * are not watched are ignored.
+   * @param fd The file descriptor to stop watching.
+   */
+  void unwatch(int fd);
+
+  /**
+   * @brief Creates a disarmed timer.
+   * @param onExpired The callback to call each time the timer expires.
+   * @return The identifier of the timer.
+   * @throws Exceptions::ThreadException if the timer cannot be created.
+   */
+  int createTimer(Callback onExpired);
+
+  /**
+   * @brief Arms a timer.
+   * @param timer The identifier of the timer.
+   * @param deadline When the timer first expires.
+   * @param interval The period after the first expiry, zero for a one-shot
+   * timer.
+   */
+  void setTimer(int timer, std::chrono::steady_clock::time_point deadline,
+                std::chrono::nanoseconds interval =
+                    std::chrono::nanoseconds::zero());
+
+  /**
+   * @brief Disarms a timer.
+   * @param timer The identifier of the timer.
+   */
+  void cancelTimer(int timer);
+
+  /**
+   * @brief Queues a callback to run on the loop thread.
+   * This method is thread-safe.
+   * @param callback The callback to run.
+   */
+  void post(Callback callback);
+
+  /**
+   * @brief Runs the loop until stop() is called.
+   * A loop that was stopped does not run again.
+   */
+  void run();
+
+  /**
+   * @brief Makes run() return after the current callback.
+   * This method is thread-safe.
+   */
+  void stop();
+
+private:
+  /**
+   * @brief Runs the callbacks posted since the last wakeup.
+   */
+  void runPosted();
+
+  int m_epollFd = -1;
+  int m_wakeupFd = -1;
+  std::atomic<bool> m_stopRequested{false};
+  std::unordered_map<int, std::shared_ptr<Callback>> m_readers;
+  std::unordered_map<int, Callback> m_timers;
+
+  std::mutex m_postedMutex;
+  std::vector<Callback> m_posted;
+};
+} // namespace Plazza::Core
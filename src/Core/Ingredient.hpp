@@ -0,0 +1,24 @@
+/**
+ * @file Ingredient.hpp
+ * @brief Defines the Ingredient enum.
+ */
+
+#pragma once
+
+namespace Plazza::Core {
+/**
+ * @enum Ingredient
+ * @brief Enum representing different ingredients of pizzas.
+ */
+enum class Ingredient {
+  Dough,
+  Tomato,
+  Gruyere,
+  Ham,
+  Mushrooms,
+  Steak,
+  Eggplant,
+  GoatCheese,
+  ChiefLove
+};
+} // namespace Plazza::Core
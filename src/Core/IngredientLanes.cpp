@@ -0,0 +1,123 @@
+/**
+ * @file IngredientLanes.cpp
+ * @brief Implements the batched stock feasibility kernels.
+ */
+
+#include "Core/IngredientLanes.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace Plazza::Core {
+namespace {
+using FeasibleKernel = void (*)(IngredientLanes, const IngredientLanes *,
+                                std::size_t, std::size_t, uint64_t *);
+
+void feasibleMaskScalar(IngredientLanes stock, const IngredientLanes *needs,
+                        std::size_t first, std::size_t count, uint64_t *mask) {
+  for (std::size_t i = first; i < count; ++i) {
+    if (lanesCover(stock, needs[i])) {
+      mask[i / 64] |= 1ULL << (i % 64);
+    }
+  }
+}
+
+#if defined(__x86_64__)
+void feasibleMaskSse2(IngredientLanes stock, const IngredientLanes *needs,
+                      std::size_t first, std::size_t count, uint64_t *mask) {
+  const __m128i guards = _mm_set1_epi64x(static_cast<long long>(LANE_GUARDS));
+  const __m128i guarded =
+      _mm_set1_epi64x(static_cast<long long>(stock | LANE_GUARDS));
+  std::size_t i = first;
+
+  for (; i + 2 <= count; i += 2) {
+    __m128i need =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(needs + i));
+    __m128i borrows =
+        _mm_xor_si128(_mm_and_si128(_mm_sub_epi64(guarded, need), guards),
+                      guards);
+    int words = _mm_movemask_ps(
+        _mm_castsi128_ps(_mm_cmpeq_epi32(borrows, _mm_setzero_si128())));
+    uint64_t bits = ((words & 0x3) == 0x3 ? 1U : 0U) |
+                    ((words & 0xC) == 0xC ? 2U : 0U);
+    mask[i / 64] |= bits << (i % 64);
+  }
+  feasibleMaskScalar(stock, needs, i, count, mask);
+}
+
+__attribute__((target("avx2"))) void
+feasibleMaskAvx2(IngredientLanes stock, const IngredientLanes *needs,
+                 std::size_t first, std::size_t count, uint64_t *mask) {
+  const __m256i guards =
+      _mm256_set1_epi64x(static_cast<long long>(LANE_GUARDS));
+  const __m256i guarded =
+      _mm256_set1_epi64x(static_cast<long long>(stock | LANE_GUARDS));
+  std::size_t i = first;
+
+  for (; i + 4 <= count; i += 4) {
+    __m256i need =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(needs + i));
+    __m256i kept = _mm256_and_si256(_mm256_sub_epi64(guarded, need), guards);
+    uint64_t bits = static_cast<uint64_t>(_mm256_movemask_pd(
+        _mm256_castsi256_pd(_mm256_cmpeq_epi64(kept, guards))));
+    mask[i / 64] |= bits << (i % 64);
+  }
+  feasibleMaskSse2(stock, needs, i, count, mask);
+}
+#endif
+
+FeasibleKernel kernelOf(LaneKernel kernel) {
+  switch (kernel) {
+#if defined(__x86_64__)
+  case LaneKernel::Avx2:
+    return feasibleMaskAvx2;
+  case LaneKernel::Sse2:
+    return feasibleMaskSse2;
+#endif
+  default:
+    return feasibleMaskScalar;
+  }
+}
+
+FeasibleKernel selectKernel() {
+  if (laneKernelSupported(LaneKernel::Avx2)) {
+    return kernelOf(LaneKernel::Avx2);
+  }
+  if (laneKernelSupported(LaneKernel::Sse2)) {
+    return kernelOf(LaneKernel::Sse2);
+  }
+  return kernelOf(LaneKernel::Scalar);
+}
+} // namespace
+
+bool laneKernelSupported(LaneKernel kernel) {
+  switch (kernel) {
+  case LaneKernel::Scalar:
+    return true;
+#if defined(__x86_64__)
+  case LaneKernel::Sse2:
+    return true;
+  case LaneKernel::Avx2:
+    return __builtin_cpu_supports("avx2");
+#endif
+  default:
+    return false;
+  }
+}
+
+void feasibleMask(IngredientLanes stock, const IngredientLanes *needs,
+                  std::size_t count, uint64_t *mask) {
+  static const FeasibleKernel kernel = selectKernel();
+
+  std::fill(mask, mask + (count + 63) / 64, 0);
+  kernel(stock, needs, 0, count, mask);
+}
+
+void feasibleMask(IngredientLanes stock, const IngredientLanes *needs,
+                  std::size_t count, uint64_t *mask, LaneKernel kernel) {
+  std::fill(mask, mask + (count + 63) / 64, 0);
+  kernelOf(kernel)(stock, needs, 0, count, mask);
+}
+} // namespace Plazza::Core
@@ -0,0 +1,167 @@
+/**
+ * @file IngredientLanes.hpp
+ * @brief Defines helpers packing one count per ingredient into a single word.
+ */
+
+#pragma once
+
+#include "Core/Ingredient.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace Plazza::Core {
+/**
+ * @brief Ingredient counts packed into 7-bit lanes, one lane per ingredient.
+ * The top bit of each lane is a guard bit kept clear, so a lane holds at most
+ * LANE_MAX and whole words can be compared and subtracted without borrows
+ * crossing lanes.
+ */
+using IngredientLanes = uint64_t;
+
+constexpr uint32_t INGREDIENT_COUNT =
+    static_cast<uint32_t>(Ingredient::ChiefLove) + 1;
+constexpr uint32_t LANE_BITS = 7;
+constexpr uint64_t LANE_MAX = (1ULL << (LANE_BITS - 1)) - 1;
+
+static_assert(INGREDIENT_COUNT * LANE_BITS <= 64,
+              "ingredient lanes must fit in 64 bits");
+
+/**
+ * @brief Spreads a value into every ingredient lane.
+ * @param value The value to store in each lane, at most 127.
+ * @return The packed lanes.
+ */
+constexpr IngredientLanes broadcastLanes(uint64_t value) {
+  IngredientLanes lanes = 0;
+  for (uint32_t i = 0; i < INGREDIENT_COUNT; ++i) {
+    lanes |= value << (i * LANE_BITS);
+  }
+  return lanes;
+}
+
+constexpr IngredientLanes LANE_GUARDS = broadcastLanes(LANE_MAX + 1);
+
+/**
+ * @brief Gets the lane holding one unit of an ingredient.
+ * @param ingredient The ingredient.
+ * @return The packed lanes with a count of one for the ingredient.
+ */
+constexpr IngredientLanes laneUnit(Ingredient ingredient) {
+  return 1ULL << (static_cast<uint32_t>(ingredient) * LANE_BITS);
+}
+
+/**
+ * @brief Reads the count of an ingredient.
+ * @param lanes The packed lanes.
+ * @param ingredient The ingredient to read.
+ * @return The count stored in the ingredient's lane.
+ */
+constexpr uint32_t laneCount(IngredientLanes lanes, Ingredient ingredient) {
+  return static_cast<uint32_t>(
+      (lanes >> (static_cast<uint32_t>(ingredient) * LANE_BITS)) & LANE_MAX);
+}
+
+/**
+ * @brief Checks that every lane of stock holds at least the same lane of need.
+ * @param stock The available counts.
+ * @param need The required counts.
+ * @return True if the stock covers the need, false otherwise.
+ */
+constexpr bool lanesCover(IngredientLanes stock, IngredientLanes need) {
+  return (((stock | LANE_GUARDS) - need) & LANE_GUARDS) == LANE_GUARDS;
+}
+
+/**
+ * @brief Marks the lanes holding a non-zero count.
+ * Adding LANE_MAX to a lane carries into its guard bit exactly when the lane
+ * is not zero, and never into the next lane.
+ * @param lanes The packed lanes, with guard bits clear.
+ * @return The guard bit of every non-zero lane.
+ */
+constexpr IngredientLanes nonZeroLanes(IngredientLanes lanes) {
+  return (lanes + broadcastLanes(LANE_MAX)) & LANE_GUARDS;
+}
+
+/**
+ * @brief Checks if two sets of counts share an ingredient, whatever the
+ * counts.
+ * @param lhs The first counts.
+ * @param rhs The second counts.
+ * @return True if some lane is non-zero in both, false otherwise.
+ */
+constexpr bool lanesOverlap(IngredientLanes lhs, IngredientLanes rhs) {
+  return (nonZeroLanes(lhs) & nonZeroLanes(rhs)) != 0;
+}
+
+static_assert(lanesOverlap(2 * laneUnit(Ingredient::Tomato),
+                           laneUnit(Ingredient::Tomato)),
+              "lanes with disjoint bits must still overlap");
+
+/**
+ * @brief Subtracts need from stock lane by lane.
+ * @param stock The available counts, which must cover the need.
+ * @param need The counts to remove.
+ * @return The remaining counts.
+ */
+constexpr IngredientLanes subtractLanes(IngredientLanes stock,
+                                        IngredientLanes need) {
+  return ((stock | LANE_GUARDS) - need) & ~LANE_GUARDS;
+}
+
+/**
+ * @brief Adds two sets of counts lane by lane, clamping each lane to LANE_MAX.
+ * Both operands must keep their guard bits clear.
+ * @param lhs The first counts.
+ * @param rhs The second counts.
+ * @return The clamped sums.
+ */
+constexpr IngredientLanes addLanesSaturated(IngredientLanes lhs,
+                                            IngredientLanes rhs) {
+  IngredientLanes sum = lhs + rhs;
+  IngredientLanes overflowed = (sum & LANE_GUARDS) >> (LANE_BITS - 1);
+  IngredientLanes overflowMask = overflowed * ((1ULL << LANE_BITS) - 1);
+  return (sum & ~overflowMask) | (overflowed * LANE_MAX);
+}
+
+/**
+ * @enum LaneKernel
+ * @brief Implementations of the batched feasibility check.
+ */
+enum class LaneKernel {
+  Scalar, ///< One recipe per step, on any target.
+  Sse2,   ///< Two recipes per step, on x86-64.
+  Avx2    ///< Four recipes per step, on x86-64 CPUs supporting AVX2.
+};
+
+/**
+ * @brief Checks if a kernel can run on this CPU.
+ * @param kernel The kernel.
+ * @return True if the kernel is available, false otherwise.
+ */
+bool laneKernelSupported(LaneKernel kernel);
+
+/**
+ * @brief Checks a batch of recipes against the stock at once.
+ * Uses AVX2 when the CPU supports it, SSE2 otherwise on x86-64, and plain
+ * word arithmetic elsewhere.
+ * @param stock The available counts.
+ * @param needs The required counts of each recipe.
+ * @param count The number of recipes.
+ * @param mask Output bitmask, one bit per recipe, set when the stock covers
+ * it. Must hold (count + 63) / 64 words.
+ */
+void feasibleMask(IngredientLanes stock, const IngredientLanes *needs,
+                  std::size_t count, uint64_t *mask);
+
+/**
+ * @brief Checks a batch of recipes against the stock with a given kernel,
+ * to compare the kernels with each other.
+ * @param stock The available counts.
+ * @param needs The required counts of each recipe.
+ * @param count The number of recipes.
+ * @param mask Output bitmask, as for the other overload.
+ * @param kernel The kernel to use, which must be supported.
+ */
+void feasibleMask(IngredientLanes stock, const IngredientLanes *needs,
+                  std::size_t count, uint64_t *mask, LaneKernel kernel);
+} // namespace Plazza::Core
@@ -0,0 +1,51 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implements the MappedFile class.
+ */
+
+#include "Core/MappedFile.hpp"
+#include "Exceptions/ArgumentException.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Plazza::Core {
+MappedFile::MappedFile(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    throw Exceptions::ArgumentException("Failed to open " + path + ": " +
+                                        std::strerror(errno));
+  }
+
+  struct stat info = {};
+  if (::fstat(fd, &info) == -1) {
+    int error = errno;
+    ::close(fd);
+    throw Exceptions::ArgumentException("Failed to stat " + path + ": " +
+                                        std::strerror(error));
+  }
+
+  m_size = static_cast<std::size_t>(info.st_size);
+  if (m_size > 0) {
+    m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (m_data == MAP_FAILED) {
+      int error = errno;
+      m_data = nullptr;
+      ::close(fd);
+      throw Exceptions::ArgumentException("Failed to map " + path + ": " +
+                                          std::strerror(error));
+    }
+    ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+  }
+  ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (m_data != nullptr) {
+    ::munmap(m_data, m_size);
+  }
+}
+} // namespace Plazza::Core
@@ -0,0 +1,47 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Defines the MappedFile class, a read-only memory mapping of a file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Plazza::Core {
+/**
+ * @class MappedFile
+ * @brief Maps a whole file in memory, read-only, for as long as it lives.
+ */
+class MappedFile {
+public:
+  /**
+   * @brief Maps a file.
+   * @param path The path of the file.
+   * @throws Exceptions::ArgumentException if the file cannot be opened or
+   * mapped.
+   */
+  explicit MappedFile(const std::string &path);
+
+  /**
+   * @brief Destructor that unmaps the file.
+   */
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /**
+   * @brief Gets the content of the file.
+   * @return A view of the mapped bytes, empty for an empty file.
+   */
+  [[nodiscard]] std::string_view view() const {
+    return {static_cast<const char *>(m_data), m_size};
+  }
+
+private:
+  void *m_data = nullptr;
+  std::size_t m_size = 0;
+};
+} // namespace Plazza::Core
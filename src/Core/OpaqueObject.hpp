@@ -38,8 +38,9 @@ public:
   template <typename T> OpaqueObject &pack(T value) {
     static_assert(std::is_trivially_copyable_v<T>,
                   "Type must be trivially copyable");
-    const uint8_t *ptr = reinterpret_cast<const uint8_t *>(&value);
-    m_data.insert(m_data.end(), ptr, ptr + sizeof(T));
+    std::size_t offset = m_data.size();
+    m_data.resize(offset + sizeof(T));
+    std::memcpy(m_data.data() + offset, &value, sizeof(T));
     return *this;
   }
 
@@ -9,56 +9,32 @@
 #include <cstring>
 
 namespace Plazza::Core {
+namespace {
+bool equalsIgnoreCase(std::string_view text, std::string_view lowercase) {
+  if (text.size() != lowercase.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < text.size(); ++i) {
+    if ((text[i] | 0x20) != lowercase[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
 
-std::unique_ptr<Pizza> Pizza::createPizza(PizzaType type, PizzaSize size) {
-  switch (type) {
-  case PizzaType::Margarita:
-    return std::make_unique<MargaritaPizza>(size);
-  case PizzaType::Regina:
-    return std::make_unique<ReginaPizza>(size);
-  case PizzaType::Americana:
-    return std::make_unique<AmericanaPizza>(size);
-  case PizzaType::Fantasia:
-    return std::make_unique<FantasiaPizza>(size);
-  default:
+Pizza Pizza::createPizza(PizzaType type, PizzaSize size) {
+  if (recipeOf(type).baseCookingTime == 0) {
     throw Exceptions::ArgumentException(
         "Pizza::createPizza: Unknown pizza type");
   }
+  return Pizza(type, size);
 }
 
-Pizza::Pizza(PizzaType type, PizzaSize size)
-    : m_type(type), m_size(size), m_baseCookingTime(0) {}
-
 std::string Pizza::getName() const { return toString(m_type); }
 
 std::string Pizza::getSizeName() const { return toString(m_size); }
 
-MargaritaPizza::MargaritaPizza(PizzaSize size)
-    : Pizza(PizzaType::Margarita, size) {
-  m_ingredients = {Ingredient::Dough, Ingredient::Tomato, Ingredient::Gruyere};
-  m_baseCookingTime = 1;
-}
-
-ReginaPizza::ReginaPizza(PizzaSize size) : Pizza(PizzaType::Regina, size) {
-  m_ingredients = {Ingredient::Dough, Ingredient::Tomato, Ingredient::Gruyere,
-                   Ingredient::Ham, Ingredient::Mushrooms};
-  m_baseCookingTime = 2;
-}
-
-AmericanaPizza::AmericanaPizza(PizzaSize size)
-    : Pizza(PizzaType::Americana, size) {
-  m_ingredients = {Ingredient::Dough, Ingredient::Tomato, Ingredient::Gruyere,
-                   Ingredient::Steak};
-  m_baseCookingTime = 2;
-}
-
-FantasiaPizza::FantasiaPizza(PizzaSize size)
-    : Pizza(PizzaType::Fantasia, size) {
-  m_ingredients = {Ingredient::Dough, Ingredient::Tomato, Ingredient::Eggplant,
-                   Ingredient::GoatCheese, Ingredient::ChiefLove};
-  m_baseCookingTime = 4;
-}
-
 std::string toString(PizzaType type) {
   switch (type) {
   case PizzaType::Regina:
@@ -116,44 +92,75 @@ std::string toString(Ingredient ingredient) {
   }
 }
 
-PizzaType pizzaTypeFromString(const std::string &type) {
-  std::string normalizedType = type;
-  std::transform(normalizedType.begin(), normalizedType.end(),
-                 normalizedType.begin(),
-                 [](unsigned char c) { return std::tolower(c); });
+std::optional<PizzaType> findPizzaType(std::string_view name) noexcept {
+  switch (name.size()) {
+  case 6:
+    if (equalsIgnoreCase(name, "regina"))
+      return PizzaType::Regina;
+    break;
+  case 8:
+    if (equalsIgnoreCase(name, "fantasia"))
+      return PizzaType::Fantasia;
+    break;
+  case 9:
+    if (equalsIgnoreCase(name, "margarita"))
+      return PizzaType::Margarita;
+    if (equalsIgnoreCase(name, "americana"))
+      return PizzaType::Americana;
+    break;
+  default:
+    break;
+  }
+  return std::nullopt;
+}
 
-  if (normalizedType == "regina")
-    return PizzaType::Regina;
-  if (normalizedType == "margarita")
-    return PizzaType::Margarita;
-  if (normalizedType == "americana")
-    return PizzaType::Americana;
-  if (normalizedType == "fantasia")
-    return PizzaType::Fantasia;
+std::optional<PizzaSize> findPizzaSize(std::string_view name) noexcept {
+  switch (name.size()) {
+  case 1:
+    switch (name[0]) {
+    case 'S':
+    case 's':
+      return PizzaSize::S;
+    case 'M':
+    case 'm':
+      return PizzaSize::M;
+    case 'L':
+    case 'l':
+      return PizzaSize::L;
+    default:
+      break;
+    }
+    break;
+  case 2:
+    if (equalsIgnoreCase(name, "xl"))
+      return PizzaSize::XL;
+    break;
+  case 3:
+    if (equalsIgnoreCase(name, "xxl"))
+      return PizzaSize::XXL;
+    break;
+  default:
+    break;
+  }
+  return std::nullopt;
+}
 
-  throw Exceptions::ArgumentException(
-      "Pizza::pizzaTypeFromString: Invalid pizza type: " + type);
+PizzaType pizzaTypeFromString(const std::string &type) {
+  std::optional<PizzaType> pizzaType = findPizzaType(type);
+  if (!pizzaType) {
+    throw Exceptions::ArgumentException(
+        "Pizza::pizzaTypeFromString: Invalid pizza type: " + type);
+  }
+  return *pizzaType;
 }
 
 PizzaSize pizzaSizeFromString(const std::string &size) {
-  std::string normalizedSize = size;
-  std::transform(normalizedSize.begin(), normalizedSize.end(),
-                 normalizedSize.begin(),
-                 [](unsigned char c) { return std::toupper(c); });
-
-  if (normalizedSize == "S")
-    return PizzaSize::S;
-  if (normalizedSize == "M")
-    return PizzaSize::M;
-  if (normalizedSize == "L")
-    return PizzaSize::L;
-  if (normalizedSize == "XL")
-    return PizzaSize::XL;
-  if (normalizedSize == "XXL")
-    return PizzaSize::XXL;
-
-  throw Exceptions::ArgumentException(
-      "Pizza::pizzaSizeFromString: Invalid pizza size: " + size);
+  std::optional<PizzaSize> pizzaSize = findPizzaSize(size);
+  if (!pizzaSize) {
+    throw Exceptions::ArgumentException(
+        "Pizza::pizzaSizeFromString: Invalid pizza size: " + size);
+  }
+  return *pizzaSize;
 }
 
 } // namespace Plazza::Core
@@ -1,13 +1,17 @@
 /**
  * @file Pizza.hpp
- * @brief Defines the Pizza class and its derived classes.
+ * @brief Defines the Pizza value type and the recipe table.
  */
 
 #pragma once
 
-#include <memory>
+#include "Core/Ingredient.hpp"
+#include "Core/IngredientLanes.hpp"
+#include <cstdint>
+#include <optional>
 #include <string>
-#include <vector>
+#include <string_view>
+#include <type_traits>
 
 namespace Plazza::Core {
 
@@ -24,75 +28,103 @@ enum class PizzaType { Regina = 1, Margarita = 2, Americana = 4, Fantasia = 8 };
 enum class PizzaSize { S = 1, M = 2, L = 4, XL = 8, XXL = 16 };
 
 /**
- * @enum Ingredient
- * @brief Enum representing different ingredients of pizzas.
+ * @struct Recipe
+ * @brief Compile-time description of a pizza type.
  */
-enum class Ingredient {
-  Dough,
-  Tomato,
-  Gruyere,
-  Ham,
-  Mushrooms,
-  Steak,
-  Eggplant,
-  GoatCheese,
-  ChiefLove
+struct Recipe {
+  IngredientLanes ingredients; ///< One unit per ingredient of the recipe.
+  uint32_t baseCookingTime;    ///< Cooking time in seconds, 0 if unknown.
 };
 
+/**
+ * @brief Gets the recipe of a pizza type.
+ * @param type Type of the pizza.
+ * @return The recipe, with no ingredients and no cooking time if the type is
+ * not valid.
+ */
+constexpr Recipe recipeOf(PizzaType type) {
+  switch (type) {
+  case PizzaType::Margarita:
+    return {laneUnit(Ingredient::Dough) + laneUnit(Ingredient::Tomato) +
+                laneUnit(Ingredient::Gruyere),
+            1};
+  case PizzaType::Regina:
+    return {laneUnit(Ingredient::Dough) + laneUnit(Ingredient::Tomato) +
+                laneUnit(Ingredient::Gruyere) + laneUnit(Ingredient::Ham) +
+                laneUnit(Ingredient::Mushrooms),
+            2};
+  case PizzaType::Americana:
+    return {laneUnit(Ingredient::Dough) + laneUnit(Ingredient::Tomato) +
+                laneUnit(Ingredient::Gruyere) + laneUnit(Ingredient::Steak),
+            2};
+  case PizzaType::Fantasia:
+    return {laneUnit(Ingredient::Dough) + laneUnit(Ingredient::Tomato) +
+                laneUnit(Ingredient::Eggplant) +
+                laneUnit(Ingredient::GoatCheese) +
+                laneUnit(Ingredient::ChiefLove),
+            4};
+  default:
+    return {0, 0};
+  }
+}
+
 /**
  * @class Pizza
- * @brief Base class for all pizza types.
+ * @brief A pizza, identified by its type and size.
+ * Pizzas are small trivially copyable values; everything else about them
+ * comes from the recipe table.
  */
 class Pizza {
 public:
   /**
-   * @brief Constructor for Pizza.
-   * @param type Type of the pizza.
-   * @param size Size of the pizza.
+   * @brief Default constructor for Pizza.
    */
-  Pizza(PizzaType type, PizzaSize size);
+  constexpr Pizza() = default;
 
   /**
-   * @brief Default destructor for Pizza.
+   * @brief Constructor for Pizza.
+   * @param type Type of the pizza.
+   * @param size Size of the pizza.
    */
-  virtual ~Pizza() = default;
+  constexpr Pizza(PizzaType type, PizzaSize size)
+      : m_type(type), m_size(size) {}
 
   /**
    * @brief Factory method to create a pizza of the specified type and size.
    * @param type Type of the pizza.
    * @param size Size of the pizza.
-   * @return A unique pointer to the created pizza.
+   * @return The created pizza.
    * @throws ArgumentException if the type is not valid.
    */
-  static std::unique_ptr<Pizza> createPizza(PizzaType type, PizzaSize size);
+  static Pizza createPizza(PizzaType type, PizzaSize size);
 
   /**
    * @brief Get the type of the pizza.
    * @return The type of the pizza.
    */
-  PizzaType getType() const { return m_type; }
+  constexpr PizzaType getType() const { return m_type; }
 
   /**
    * @brief Get the size of the pizza.
    * @return The size of the pizza.
    */
-  PizzaSize getSize() const { return m_size; }
+  constexpr PizzaSize getSize() const { return m_size; }
 
   /**
    * @brief Get the cooking time of the pizza.
    * @param multiplier Multiplier for the cooking time.
    * @return The cooking time of the pizza.
    */
-  double getCookingTime(double multiplier) const {
-    return m_baseCookingTime * multiplier;
+  constexpr double getCookingTime(double multiplier) const {
+    return recipeOf(m_type).baseCookingTime * multiplier;
   }
 
   /**
    * @brief Get the ingredients of the pizza.
-   * @return A vector of ingredients.
+   * @return The ingredients, one unit per lane.
    */
-  const std::vector<Ingredient> &getIngredients() const {
-    return m_ingredients;
+  constexpr IngredientLanes getIngredients() const {
+    return recipeOf(m_type).ingredients;
   }
 
   /**
@@ -107,48 +139,14 @@ public:
    */
   std::string getSizeName() const;
 
-protected:
-  PizzaType m_type;
-  PizzaSize m_size;
-  std::vector<Ingredient> m_ingredients;
-  int m_baseCookingTime;
+private:
+  PizzaType m_type = PizzaType::Regina;
+  PizzaSize m_size = PizzaSize::S;
 };
 
-/**
- * @class MargaritaPizza
- * @brief Class representing a Margarita pizza.
- */
-class MargaritaPizza : public Pizza {
-public:
-  MargaritaPizza(PizzaSize size);
-};
-
-/**
- * @class ReginaPizza
- * @brief Class representing a Regina pizza.
- */
-class ReginaPizza : public Pizza {
-public:
-  ReginaPizza(PizzaSize size);
-};
-
-/**
- * @class AmericanaPizza
- * @brief Class representing an Americana pizza.
- */
-class AmericanaPizza : public Pizza {
-public:
-  AmericanaPizza(PizzaSize size);
-};
-
-/**
- * @class FantasiaPizza
- * @brief Class representing a Fantasia pizza.
- */
-class FantasiaPizza : public Pizza {
-public:
-  FantasiaPizza(PizzaSize size);
-};
+static_assert(sizeof(Pizza) == 8, "Pizza must stay an 8-byte value");
+static_assert(std::is_trivially_copyable_v<Pizza>,
+              "Pizza must stay trivially copyable");
 
 /**
  * @brief Convert PizzaType to string.
@@ -171,6 +169,20 @@ std::string toString(PizzaSize size);
  */
 std::string toString(Ingredient ingredient);
 
+/**
+ * @brief Looks up a pizza type by name, ignoring case.
+ * @param name The name of the pizza type.
+ * @return The matching PizzaType, or std::nullopt if there is none.
+ */
+std::optional<PizzaType> findPizzaType(std::string_view name) noexcept;
+
+/**
+ * @brief Looks up a pizza size by name, ignoring case.
+ * @param name The name of the pizza size.
+ * @return The matching PizzaSize, or std::nullopt if there is none.
+ */
+std::optional<PizzaSize> findPizzaSize(std::string_view name) noexcept;
+
 /**
  * @brief Convert string to PizzaType.
  * @param type The string representation of the pizza type.
@@ -48,13 +48,13 @@ public:
    * @brief Sets the order ID.
    * @param orderId The ID of the pizza order.
    */
-  void setOrderId(uint32_t orderId) { m_orderId = orderId; }
+  void setOrderId(uint64_t orderId) { m_orderId = orderId; }
 
   /**
    * @brief Gets the order ID.
    * @return The order ID of the pizza packet.
    */
-  [[nodiscard]] uint32_t getOrderId() const { return m_orderId; }
+  [[nodiscard]] uint64_t getOrderId() const { return m_orderId; }
 
   /**
    * @brief Sets the kitchen ID.
@@ -109,7 +109,7 @@ public:
 private:
   PizzaType m_type = PizzaType::Margarita;
   PizzaSize m_size = PizzaSize::S;
-  uint32_t m_orderId = 0;
+  uint64_t m_orderId = 0;
   uint32_t m_kitchenId = 0;
 };
 } // namespace Plazza::Core
@@ -5,21 +5,55 @@
 
 #include "Core/Process.hpp"
 #include "Exceptions/ProcessException.hpp"
+#include <cerrno>
+#include <chrono>
+#include <poll.h>
 #include <signal.h>
+#include <sys/syscall.h>
 #include <sys/wait.h>
+#include <thread>
 
 namespace Plazza::Core {
+namespace {
+int openPidfd(pid_t pid) {
+  return static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+}
+
+int sendSignal(int pidfd, int signal) {
+  return static_cast<int>(
+      ::syscall(SYS_pidfd_send_signal, pidfd, signal, nullptr, 0));
+}
+
+bool hasExited(int pidfd, int timeoutMs) {
+  pollfd descriptor{pidfd, POLLIN, 0};
+  int ready = 0;
+  do {
+    ready = ::poll(&descriptor, 1, timeoutMs);
+  } while (ready == -1 && errno == EINTR);
+  return ready != 0;
+}
+} // namespace
+
+Process::Process(pid_t pid, int pidfd)
+    : m_pid(pid), m_forked(true), m_adopted(true),
+      m_pidfd(pidfd != -1 ? pidfd : openPidfd(pid)) {}
 
 Process::~Process() {
   if (m_forked && m_pid > 0) {
     terminate();
   }
+  if (m_pidfd != -1) {
+    ::close(m_pidfd);
+  }
 }
 
 Process::Process(Process &&other) noexcept
-    : m_pid(other.m_pid), m_forked(other.m_forked) {
+    : m_pid(other.m_pid), m_forked(other.m_forked),
+      m_adopted(other.m_adopted), m_pidfd(other.m_pidfd) {
   other.m_pid = -1;
   other.m_forked = false;
+  other.m_adopted = false;
+  other.m_pidfd = -1;
 }
 
 Process &Process::operator=(Process &&other) noexcept {
@@ -27,10 +61,17 @@ Process &Process::operator=(Process &&other) noexcept {
     if (m_forked && m_pid > 0) {
       terminate();
     }
+    if (m_pidfd != -1) {
+      ::close(m_pidfd);
+    }
     m_pid = other.m_pid;
     m_forked = other.m_forked;
+    m_adopted = other.m_adopted;
+    m_pidfd = other.m_pidfd;
     other.m_pid = -1;
     other.m_forked = false;
+    other.m_adopted = false;
+    other.m_pidfd = -1;
   }
   return *this;
 }
@@ -51,13 +92,22 @@ void Process::fork(std::function<void()> processFunction) {
     }
   } else {
     m_forked = true;
+    m_pidfd = openPidfd(m_pid);
   }
 }
 
 void Process::wait() {
   if (m_forked && m_pid > 0) {
-    int status;
-    ::waitpid(m_pid, &status, 0);
+    if (m_adopted && m_pidfd != -1) {
+      hasExited(m_pidfd, -1);
+    } else if (m_adopted) {
+      while (isRunning()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    } else {
+      int status;
+      ::waitpid(m_pid, &status, 0);
+    }
     m_forked = false;
     m_pid = -1;
   }
@@ -68,6 +118,13 @@ bool Process::isRunning() const {
     return false;
   }
 
+  if (m_adopted && m_pidfd != -1) {
+    return !hasExited(m_pidfd, 0);
+  }
+  if (m_adopted) {
+    return ::kill(m_pid, 0) == 0 || errno == EPERM;
+  }
+
   int status;
 
   pid_t result = ::waitpid(m_pid, &status, WNOHANG);
@@ -76,7 +133,11 @@ bool Process::isRunning() const {
 
 void Process::terminate() {
   if (m_forked && m_pid > 0) {
-    ::kill(m_pid, SIGTERM);
+    if (m_pidfd != -1) {
+      sendSignal(m_pidfd, SIGTERM);
+    } else {
+      ::kill(m_pid, SIGTERM);
+    }
     wait();
   }
 }
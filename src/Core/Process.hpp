@@ -22,6 +22,17 @@ public:
    */
   Process() = default;
 
+  /**
+   * @brief Tracks a process forked by another process of the program, such
+   * as the kitchen zygote.
+   * Such a process is not a child, so it cannot be reaped and is waited on
+   * through its pidfd instead.
+   * @param pid The process ID of the process.
+   * @param pidfd A pidfd of the process opened by its parent, which the
+   * Process then owns, or -1 to open one from the process ID.
+   */
+  explicit Process(pid_t pid, int pidfd = -1);
+
   /**
    * @brief Destructor that ensures the process is terminated if it was forked.
    */
@@ -68,13 +79,25 @@ public:
    */
   [[nodiscard]] pid_t getPid() const { return m_pid; }
 
+  /**
+   * @brief Gets the pidfd of the process, which becomes readable when the
+   * process exits and can be watched by an event loop.
+   * It stays open until the Process is destroyed.
+   * @return The pidfd, -1 if the system does not support pidfds.
+   */
+  [[nodiscard]] int getDescriptor() const { return m_pidfd; }
+
   /**
    * @brief Terminates the forked process.
+   * The signal goes through the pidfd when there is one, so it cannot reach
+   * another process that reused the process ID.
    */
   void terminate();
 
 private:
   pid_t m_pid = -1;
   bool m_forked = false;
+  bool m_adopted = false;
+  int m_pidfd = -1;
 };
 } // namespace Plazza::Core
@@ -9,6 +9,7 @@
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <stop_token>
 
 namespace Plazza::Core {
 /**
@@ -44,6 +45,23 @@ public:
     return result;
   }
 
+  /**
+   * @brief Blocks until an item is available or a stop is requested.
+   * @param stopToken Token whose stop request wakes the waiting thread.
+   * @return An optional containing the popped item, or std::nullopt if a stop
+   * was requested while the queue was empty.
+   */
+  std::optional<T> waitPop(std::stop_token stopToken) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_condition.wait(lock, stopToken,
+                          [this]() { return !m_queue.empty(); })) {
+      return std::nullopt;
+    }
+    T result = std::move(m_queue.front());
+    m_queue.pop();
+    return result;
+  }
+
   /**
    * @brief Checks if the queue is empty.
    * @return True if the queue is empty, false otherwise.
@@ -65,7 +83,7 @@ public:
 private:
   mutable std::mutex m_mutex;
   std::queue<T> m_queue;
-  std::condition_variable m_condition;
+  std::condition_variable_any m_condition;
 };
 
 } // namespace Plazza::Core
@@ -0,0 +1,143 @@
+/**
+ * @file Zygote.cpp
+ * @brief Implements the Zygote class.
+ */
+
+#include "Core/Zygote.hpp"
+#include "Exceptions/ProcessException.hpp"
+#include <cerrno>
+#include <cstring>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Plazza::Core {
+Zygote::~Zygote() {
+  if (m_socket != -1) {
+    ::close(m_socket);
+    m_process.wait();
+  }
+}
+
+void Zygote::start(Entry entry) {
+  int sockets[2];
+  if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) == -1) {
+    throw Exceptions::ProcessException("Failed to create zygote socket: " +
+                                       std::string(std::strerror(errno)));
+  }
+
+  try {
+    m_process.fork([socket = sockets[1], parentSocket = sockets[0],
+                    entry = std::move(entry)]() {
+      ::close(parentSocket);
+      serve(socket, entry);
+    });
+  } catch (...) {
+    ::close(sockets[0]);
+    ::close(sockets[1]);
+    throw;
+  }
+  ::close(sockets[1]);
+  m_socket = sockets[0];
+}
+
+Process Zygote::spawn(const std::string &request) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_socket == -1) {
+    throw Exceptions::ProcessException("Zygote is not started");
+  }
+  if (request.empty() || request.size() > MAX_REQUEST_SIZE) {
+    throw Exceptions::ProcessException("Invalid zygote request size");
+  }
+
+  if (::send(m_socket, request.data(), request.size(), MSG_NOSIGNAL) !=
+      static_cast<ssize_t>(request.size())) {
+    throw Exceptions::ProcessException("Zygote failed to fork a process");
+  }
+
+  pid_t pid = -1;
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+  iovec data{&pid, sizeof(pid)};
+  msghdr message{};
+  message.msg_iov = &data;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  ssize_t received = ::recvmsg(m_socket, &message, MSG_CMSG_CLOEXEC);
+  int pidfd = -1;
+  cmsghdr *header = CMSG_FIRSTHDR(&message);
+  if (header != nullptr && header->cmsg_level == SOL_SOCKET &&
+      header->cmsg_type == SCM_RIGHTS) {
+    std::memcpy(&pidfd, CMSG_DATA(header), sizeof(pidfd));
+  }
+
+  if (received != sizeof(pid) || pid == -1) {
+    if (pidfd != -1) {
+      ::close(pidfd);
+    }
+    throw Exceptions::ProcessException("Zygote failed to fork a process");
+  }
+  return Process(pid, pidfd);
+}
+
+void Zygote::serve(int socket, const Entry &entry) {
+  struct sigaction action {};
+  action.sa_handler = SIG_DFL;
+  action.sa_flags = SA_NOCLDWAIT;
+  sigaction(SIGCHLD, &action, nullptr);
+
+  char buffer[MAX_REQUEST_SIZE];
+  while (true) {
+    ssize_t received = ::recv(socket, buffer, sizeof(buffer), 0);
+    if (received == -1 && errno == EINTR) {
+      continue;
+    }
+    if (received <= 0) {
+      return;
+    }
+
+    pid_t pid = ::fork();
+    if (pid == 0) {
+      ::close(socket);
+      action.sa_flags = 0;
+      sigaction(SIGCHLD, &action, nullptr);
+      try {
+        entry(std::string(buffer, received));
+        std::exit(0);
+      } catch (...) {
+        std::exit(1);
+      }
+    }
+
+    int pidfd = -1;
+    if (pid > 0) {
+      pidfd = static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+    }
+    reply(socket, pid, pidfd);
+    if (pidfd != -1) {
+      ::close(pidfd);
+    }
+  }
+}
+
+void Zygote::reply(int socket, pid_t pid, int pidfd) {
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+  iovec data{&pid, sizeof(pid)};
+  msghdr message{};
+  message.msg_iov = &data;
+  message.msg_iovlen = 1;
+
+  if (pidfd != -1) {
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    cmsghdr *header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(header), &pidfd, sizeof(pidfd));
+  }
+  ::sendmsg(socket, &message, MSG_NOSIGNAL);
+}
+} // namespace Plazza::Core
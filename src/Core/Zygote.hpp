@@ -0,0 +1,93 @@
+/**
+ * @file Zygote.hpp
+ * @brief Defines the Zygote class, which forks processes on behalf of a
+ * multithreaded parent.
+ */
+
+#pragma once
+
+#include "Core/Process.hpp"
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace Plazza::Core {
+/**
+ * @class Zygote
+ * @brief A small single-threaded process, forked early, that forks children
+ * on request.
+ * Children then start from the zygote's address space, which holds no other
+ * threads nor their locks, rather than from the current one. Requests and
+ * replies go through a socket pair. Children are reaped by the system, so
+ * the caller tracks them as adopted processes, through a pidfd the zygote
+ * opens as it forks them and passes along with the reply.
+ */
+class Zygote {
+public:
+  using Entry = std::function<void(const std::string &)>;
+
+  /**
+   * @brief Default constructor.
+   */
+  Zygote() = default;
+
+  /**
+   * @brief Destructor that stops the zygote.
+   * Children already spawned keep running.
+   */
+  ~Zygote();
+
+  Zygote(const Zygote &) = delete;
+  Zygote &operator=(const Zygote &) = delete;
+
+  /**
+   * @brief Forks the zygote.
+   * Must be called before the caller starts any thread.
+   * @param entry The function each child runs, given the spawn request.
+   * @throws Exceptions::ProcessException if the zygote cannot be started.
+   */
+  void start(Entry entry);
+
+  /**
+   * @brief Asks the zygote to fork a child.
+   * This method is thread-safe.
+   * @param request The request given to the child's entry function, at most
+   * MAX_REQUEST_SIZE bytes.
+   * @return The child, tracked as an adopted process.
+   * @throws Exceptions::ProcessException if the zygote cannot fork.
+   */
+  Process spawn(const std::string &request);
+
+  /**
+   * @brief Checks if the zygote is running.
+   * @return True if the zygote is running, false otherwise.
+   */
+  [[nodiscard]] bool isRunning() const { return m_process.isRunning(); }
+
+private:
+  static constexpr size_t MAX_REQUEST_SIZE = 1024;
+
+  /**
+   * @brief Serves spawn requests until the socket is closed.
+   * Runs in the zygote.
+   * @param socket The zygote end of the socket pair.
+   * @param entry The function each child runs.
+   */
+  static void serve(int socket, const Entry &entry);
+
+  /**
+   * @brief Replies to a spawn request with the process ID of the child and,
+   * if one could be opened, its pidfd as SCM_RIGHTS ancillary data.
+   * Runs in the zygote.
+   * @param socket The zygote end of the socket pair.
+   * @param pid The process ID of the child, -1 if the fork failed.
+   * @param pidfd The pidfd of the child, -1 if none.
+   */
+  static void reply(int socket, pid_t pid, int pidfd);
+
+  Process m_process;
+  int m_socket = -1;
+  std::mutex m_mutex;
+};
+} // namespace Plazza::Core
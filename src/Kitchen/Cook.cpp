@@ -1,12 +1,13 @@
 #include "Kitchen/Cook.hpp"
 #include "Core/Pizza.hpp"
-#include <thread>
+#include <chrono>
 
 namespace Plazza::Kitchen {
-Cook::Cook(uint32_t id, std::function<void(const Core::Pizza &)> callback,
+Cook::Cook(uint32_t id, Core::ThreadQueue<CookingTask> &workQueue,
+           std::function<void(const CookingTask &)> callback,
            double timeMultiplier)
     : m_id(id), m_callback(std::move(callback)),
-      m_timeMultiplier(timeMultiplier) {}
+      m_timeMultiplier(timeMultiplier), m_workQueue(workQueue) {}
 
 Cook::~Cook() { stop(); }
 
@@ -14,57 +15,54 @@ void Cook::start() {
   if (m_thread.joinable()) {
     return;
   }
-  m_shouldStop = false;
-  m_thread.start([this]() { cookingLoop(); });
+  m_stopSource = std::stop_source();
+  m_retireSource = std::stop_source();
+  m_hasLeft = false;
+  m_thread.start([this, stopToken = m_stopSource.get_token(),
+                  retireToken = m_retireSource.get_token()]() {
+    cookingLoop(stopToken, retireToken);
+  });
 }
 
 void Cook::stop() {
-  m_shouldStop = true;
+  m_stopSource.request_stop();
+  m_retireSource.request_stop();
   if (m_thread.joinable()) {
     m_thread.join();
   }
 }
 
-bool Cook::assignPizza(const Core::Pizza &pizza) {
-  bool expected = false;
-  if (!m_isBusy.compare_exchange_strong(expected, true)) {
-    return false;
-  }
-  m_pizzaQueue.push(pizza);
-  return true;
-}
+void Cook::retire() { m_retireSource.request_stop(); }
 
-void Cook::cookingLoop() {
-  while (!m_shouldStop) {
-    auto pizzaToCook = m_pizzaQueue.tryPop();
-    if (pizzaToCook) {
-      cookPizza(*pizzaToCook);
-      m_isBusy.store(false);
-    } else {
-      std::this_thread::yield();
-      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+void Cook::cookingLoop(std::stop_token stopToken,
+                       std::stop_token retireToken) {
+  while (!retireToken.stop_requested()) {
+    auto pizzaToCook = m_workQueue.waitPop(retireToken);
+    if (!pizzaToCook) {
+      break;
     }
+    m_isBusy.store(true);
+    cookPizza(*pizzaToCook, stopToken);
+    m_isBusy.store(false);
   }
+  m_hasLeft = true;
 }
 
-void Cook::cookPizza(const Core::Pizza &pizza) {
-  double cookingTime = pizza.getCookingTime(m_timeMultiplier);
-  std::chrono::milliseconds adjustedTime =
-      std::chrono::milliseconds(static_cast<int>(cookingTime * 1000));
+void Cook::cookPizza(const CookingTask &task, std::stop_token stopToken) {
+  std::chrono::duration<double> cookingTime(
+      task.pizza.getCookingTime(m_timeMultiplier));
+  auto deadline =
+      std::chrono::steady_clock::now() +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          cookingTime);
 
-  std::chrono::milliseconds sleepChunk = std::chrono::milliseconds(100);
-  std::chrono::milliseconds remainingTime = adjustedTime;
-
-  while (remainingTime > std::chrono::milliseconds(0) && !m_shouldStop) {
-    auto sleepTime = std::min(sleepChunk, remainingTime);
-    std::this_thread::sleep_for(sleepTime);
-    remainingTime -= sleepTime;
-  }
+  std::unique_lock<std::mutex> lock(m_timerMutex);
+  m_timer.wait_until(lock, stopToken, deadline, []() { return false; });
+  lock.unlock();
 
-  if (!m_shouldStop) {
+  if (!stopToken.stop_requested()) {
     if (m_callback) {
-      Core::Pizza completedPizza = pizza;
-      m_callback(completedPizza);
+      m_callback(task);
     }
   }
 }
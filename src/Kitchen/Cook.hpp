@@ -5,13 +5,28 @@
 
 #pragma once
 
+#include "Communication/Serialization.hpp"
 #include "Core/Pizza.hpp"
 #include "Core/Thread.hpp"
 #include "Core/ThreadQueue.hpp"
 #include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
+#include <stop_token>
 
 namespace Plazza::Kitchen {
+/**
+ * @struct CookingTask
+ * @brief A pizza handed to a cook, with the order it belongs to.
+ */
+struct CookingTask {
+  Communication::PizzaOrder order;
+  Core::Pizza pizza;
+  uint32_t tableSlot;
+  uint64_t tableTicket;
+};
+
 /**
  * @class Cook
  * @brief Manages a cook thread that prepares pizzas.
@@ -21,11 +36,13 @@ public:
   /**
    * @brief Constructs a Cook instance.
    * @param id Unique identifier for the cook.
-   * @param callback Callback function to call when a pizza is completed.
+   * @param workQueue The kitchen work queue the cook takes tasks from.
+   * @param callback Callback function to call when a task is completed.
    * @param timeMultiplier Multiplier for cooking time to simulate different
    * cooking speeds.
    */
-  Cook(uint32_t id, std::function<void(const Core::Pizza &)> callback,
+  Cook(uint32_t id, Core::ThreadQueue<CookingTask> &workQueue,
+       std::function<void(const CookingTask &)> callback,
        double timeMultiplier);
 
   /**
@@ -46,6 +63,12 @@ public:
    */
   void stop();
 
+  /**
+   * @brief Makes the cook leave once the pizza it is cooking is done.
+   * Unlike stop(), it does not wait for the thread.
+   */
+  void retire();
+
   /**
    * @brief Checks if the cook is currently busy preparing a pizza.
    * @return True if the cook is busy, false otherwise.
@@ -53,34 +76,41 @@ public:
   [[nodiscard]] bool isBusy() const { return m_isBusy.load(); }
 
   /**
-   * @brief Assigns a pizza to the cook for preparation.
-   * @param pizza The pizza to be prepared.
-   * @return True if the pizza was successfully assigned, false if the cook is
-   * busy.
+   * @brief Checks if the cooking loop has ended.
+   * @return True if the cook left, false otherwise.
    */
-  bool assignPizza(const Core::Pizza &pizza);
+  [[nodiscard]] bool hasLeft() const { return m_hasLeft.load(); }
 
 private:
   /**
-   * @brief The main cooking loop that processes pizzas from the queue.
-   * This method runs in a separate thread and continuously checks for pizzas to
-   * cook.
+   * @brief The main cooking loop that processes pizzas from the work queue.
+   * This method runs in a separate thread and sleeps on the queue until a
+   * pizza is queued or the cook is stopped or retired.
+   * @param stopToken Token signalled when the cook is stopped.
+   * @param retireToken Token signalled when the cook must take no more
+   * pizzas.
    */
-  void cookingLoop();
+  void cookingLoop(std::stop_token stopToken, std::stop_token retireToken);
 
   /**
    * @brief Cooks a pizza.
-   * This method simulates the cooking process for a given pizza.
-   * @param pizza The pizza to be cooked.
+   * This method waits until the pizza's absolute cooking deadline, returning
+   * early if the cook is stopped.
+   * @param task The task holding the pizza to be cooked.
+   * @param stopToken Token signalled when the cook is stopped.
    */
-  void cookPizza(const Core::Pizza &pizza);
+  void cookPizza(const CookingTask &task, std::stop_token stopToken);
 
   uint32_t m_id;
-  std::function<void(const Core::Pizza &)> m_callback;
+  std::function<void(const CookingTask &)> m_callback;
   double m_timeMultiplier;
   Core::Thread m_thread;
-  Core::ThreadQueue<Core::Pizza> m_pizzaQueue;
+  Core::ThreadQueue<CookingTask> &m_workQueue;
   std::atomic<bool> m_isBusy{false};
-  std::atomic<bool> m_shouldStop{false};
+  std::atomic<bool> m_hasLeft{false};
+  std::stop_source m_stopSource;
+  std::stop_source m_retireSource;
+  std::mutex m_timerMutex;
+  std::condition_variable_any m_timer;
 };
 } // namespace Plazza::Kitchen
@@ -0,0 +1,16 @@
+#include "Kitchen/CookPool.hpp"
+#include "Kitchen/CoroutineCookPool.hpp"
+#include "Kitchen/ThreadCookPool.hpp"
+
+namespace Plazza::Kitchen {
+std::unique_ptr<CookPool> CookPool::create(CookModel model, uint32_t cookCount,
+                                           Callback callback,
+                                           double timeMultiplier) {
+  if (model == CookModel::Coroutines) {
+    return std::make_unique<CoroutineCookPool>(
+        cookCount, std::move(callback), timeMultiplier);
+  }
+  return std::make_unique<ThreadCookPool>(cookCount, std::move(callback),
+                                          timeMultiplier);
+}
+} // namespace Plazza::Kitchen
@@ -0,0 +1,79 @@
+/**
+ * @file CookPool.hpp
+ * @brief Defines the CookPool interface shared by the cook models.
+ */
+
+#pragma once
+
+#include "Kitchen/Cook.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace Plazza::Kitchen {
+/**
+ * @enum CookModel
+ * @brief Enum representing how the cooks of a kitchen are run.
+ */
+enum class CookModel {
+  Threads,   ///< One OS thread per cook.
+  Coroutines ///< One coroutine per cook, all driven by a single thread.
+};
+
+/**
+ * @class CookPool
+ * @brief The cooks of a kitchen and the queue they take tasks from.
+ */
+class CookPool {
+public:
+  using Callback = std::function<void(const CookingTask &)>;
+
+  /**
+   * @brief Virtual destructor for CookPool.
+   */
+  virtual ~CookPool() = default;
+
+  /**
+   * @brief Factory method to create the cooks of a kitchen.
+   * @param model How the cooks are run.
+   * @param cookCount Number of cooks.
+   * @param callback Callback function to call when a task is completed.
+   * @param timeMultiplier Multiplier for cooking time to simulate different
+   * cooking speeds.
+   * @return A unique pointer to the created pool.
+   */
+  static std::unique_ptr<CookPool> create(CookModel model, uint32_t cookCount,
+                                          Callback callback,
+                                          double timeMultiplier);
+
+  /**
+   * @brief Starts the cooks.
+   */
+  virtual void start() = 0;
+
+  /**
+   * @brief Stops the cooks, abandoning the pizzas being cooked.
+   */
+  virtual void stop() = 0;
+
+  /**
+   * @brief Queues a task for the next free cook.
+   * @param task The task holding the pizza to be prepared.
+   */
+  virtual void submit(const CookingTask &task) = 0;
+
+  /**
+   * @brief Changes the number of cooks.
+   * Removed cooks take no new task and leave once their current pizza is
+   * done. Must be called from the thread submitting tasks.
+   * @param cookCount The new number of cooks, at least one.
+   */
+  virtual void resize(uint32_t cookCount) = 0;
+
+  /**
+   * @brief Gets the number of cooks currently cooking.
+   * @return The number of busy cooks.
+   */
+  [[nodiscard]] virtual uint32_t busyCooks() const = 0;
+};
+} // namespace Plazza::Kitchen
@@ -0,0 +1,191 @@
+#include "Kitchen/CoroutineCookPool.hpp"
+#include "Logger/Logger.hpp"
+
+namespace Plazza::Kitchen {
+CoroutineCookPool::CoroutineCookPool(uint32_t cookCount, Callback callback,
+                                     double timeMultiplier)
+    : m_callback(std::move(callback)), m_timeMultiplier(timeMultiplier),
+      m_assignedTasks(cookCount), m_activeCooks(cookCount) {
+  m_routines.reserve(cookCount);
+  for (uint32_t i = 0; i < cookCount; ++i) {
+    m_routines.push_back(cookLoop(i).handle);
+  }
+}
+
+CoroutineCookPool::~CoroutineCookPool() {
+  stop();
+  for (auto &routine : m_routines) {
+    if (routine) {
+      routine.destroy();
+    }
+  }
+}
+
+void CoroutineCookPool::start() {
+  if (m_executor.joinable()) {
+    return;
+  }
+  m_stopSource = std::stop_source();
+  m_executor.start([this, stopToken = m_stopSource.get_token()]() {
+    runExecutor(stopToken);
+  });
+}
+
+void CoroutineCookPool::stop() {
+  m_stopSource.request_stop();
+  if (m_executor.joinable()) {
+    m_executor.join();
+  }
+}
+
+void CoroutineCookPool::submit(const CookingTask &task) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_submittedTasks.push_back(task);
+  m_wakeup.notify_one();
+}
+
+void CoroutineCookPool::resize(uint32_t cookCount) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_requestedCooks = cookCount;
+  m_wakeup.notify_one();
+}
+
+uint32_t CoroutineCookPool::busyCooks() const { return m_busyCooks.load(); }
+
+void CoroutineCookPool::TaskAwaiter::await_suspend(
+    std::coroutine_handle<> handle) {
+  pool.m_idleCooks.push_back({cook, handle});
+}
+
+CookingTask CoroutineCookPool::TaskAwaiter::await_resume() const {
+  return pool.m_assignedTasks[cook];
+}
+
+void CoroutineCookPool::TimerAwaiter::await_suspend(
+    std::coroutine_handle<> handle) {
+  pool.m_timers.push({deadline, handle});
+}
+
+CoroutineCookPool::CookRoutine CoroutineCookPool::cookLoop(uint32_t cook) {
+  while (true) {
+    CookingTask task = co_await TaskAwaiter{*this, cook};
+    ++m_busyCooks;
+
+    std::chrono::duration<double> cookingTime(
+        task.pizza.getCookingTime(m_timeMultiplier));
+    co_await TimerAwaiter{
+        *this, std::chrono::steady_clock::now() +
+                   std::chrono::duration_cast<
+                       std::chrono::steady_clock::duration>(cookingTime)};
+
+    try {
+      if (m_callback) {
+        m_callback(task);
+      }
+    } catch (const std::exception &e) {
+      LOG_ERROR(std::string("Cook ") + std::to_string(cook + 1) +
+                " failed to deliver pizza: " + e.what());
+    }
+    --m_busyCooks;
+
+    if (m_cooksToRetire > 0) {
+      --m_cooksToRetire;
+      m_routines[cook] = nullptr;
+      m_freeCooks.push_back(cook);
+      co_return;
+    }
+  }
+}
+
+void CoroutineCookPool::runExecutor(std::stop_token stopToken) {
+  if (!m_routinesStarted) {
+    for (auto &routine : m_routines) {
+      routine.resume();
+    }
+    m_routinesStarted = true;
+  }
+
+  std::vector<CookingTask> submitted;
+  std::optional<uint32_t> requestedCooks;
+  while (!stopToken.stop_requested()) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      auto hasSubmissions = [this]() {
+        return !m_submittedTasks.empty() || m_requestedCooks;
+      };
+      if (m_timers.empty()) {
+        m_wakeup.wait(lock, stopToken, hasSubmissions);
+      } else {
+        m_wakeup.wait_until(lock, stopToken, m_timers.top().deadline,
+                            hasSubmissions);
+      }
+      submitted.swap(m_submittedTasks);
+      requestedCooks.swap(m_requestedCooks);
+    }
+    if (stopToken.stop_requested()) {
+      return;
+    }
+
+    if (requestedCooks) {
+      applyResize(*requestedCooks);
+      requestedCooks.reset();
+    }
+
+    m_tasks.insert(m_tasks.end(), submitted.begin(), submitted.end());
+    submitted.clear();
+
+    auto now = std::chrono::steady_clock::now();
+    while (!m_timers.empty() && m_timers.top().deadline <= now) {
+      std::coroutine_handle<> handle = m_timers.top().handle;
+      m_timers.pop();
+      handle.resume();
+      if (handle.done()) {
+        handle.destroy();
+      }
+    }
+
+    while (!m_tasks.empty() && !m_idleCooks.empty()) {
+      IdleCook idle = m_idleCooks.front();
+      m_idleCooks.pop_front();
+      m_assignedTasks[idle.cook] = m_tasks.front();
+      m_tasks.pop_front();
+      idle.handle.resume();
+    }
+  }
+}
+
+void CoroutineCookPool::applyResize(uint32_t cookCount) {
+  while (m_activeCooks < cookCount) {
+    ++m_activeCooks;
+    if (m_cooksToRetire > 0) {
+      --m_cooksToRetire;
+      continue;
+    }
+
+    uint32_t cook = 0;
+    if (!m_freeCooks.empty()) {
+      cook = m_freeCooks.back();
+      m_freeCooks.pop_back();
+    } else {
+      cook = static_cast<uint32_t>(m_routines.size());
+      m_assignedTasks.emplace_back();
+      m_routines.emplace_back();
+    }
+    m_routines[cook] = cookLoop(cook).handle;
+    m_routines[cook].resume();
+  }
+
+  while (m_activeCooks > cookCount) {
+    --m_activeCooks;
+    if (!m_idleCooks.empty()) {
+      IdleCook idle = m_idleCooks.back();
+      m_idleCooks.pop_back();
+      idle.handle.destroy();
+      m_routines[idle.cook] = nullptr;
+      m_freeCooks.push_back(idle.cook);
+    } else {
+      ++m_cooksToRetire;
+    }
+  }
+}
+} // namespace Plazza::Kitchen
@@ -0,0 +1,168 @@
+/**
+ * @file CoroutineCookPool.hpp
+ * @brief Defines the CoroutineCookPool class running cooks as coroutines.
+ */
+
+#pragma once
+
+#include "Core/Thread.hpp"
+#include "Kitchen/CookPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <stop_token>
+#include <vector>
+
+namespace Plazza::Kitchen {
+/**
+ * @class CoroutineCookPool
+ * @brief Cooks running as coroutines on a single executor thread.
+ * Each cook is a coroutine that waits for a task, then waits on a timer for
+ * the cooking time. The executor thread keeps the timers in a heap and
+ * sleeps until the earliest one is due or a task is submitted, so idle and
+ * cooking cooks cost a coroutine frame each instead of a thread.
+ */
+class CoroutineCookPool : public CookPool {
+public:
+  /**
+   * @brief Constructs a CoroutineCookPool instance.
+   * @param cookCount Number of cooks.
+   * @param callback Callback function to call when a task is completed.
+   * @param timeMultiplier Multiplier for cooking time to simulate different
+   * cooking speeds.
+   */
+  CoroutineCookPool(uint32_t cookCount, Callback callback,
+                    double timeMultiplier);
+
+  /**
+   * @brief Destructor that stops the executor and frees the cooks.
+   */
+  ~CoroutineCookPool() override;
+
+  CoroutineCookPool(const CoroutineCookPool &) = delete;
+  CoroutineCookPool &operator=(const CoroutineCookPool &) = delete;
+
+  void start() override;
+  void stop() override;
+  void submit(const CookingTask &task) override;
+  void resize(uint32_t cookCount) override;
+  [[nodiscard]] uint32_t busyCooks() const override;
+
+private:
+  /**
+   * @struct CookRoutine
+   * @brief Coroutine type of a cook, started lazily by the executor.
+   */
+  struct CookRoutine {
+    struct promise_type {
+      CookRoutine get_return_object() {
+        return {std::coroutine_handle<promise_type>::from_promise(*this)};
+      }
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      std::suspend_always final_suspend() noexcept { return {}; }
+      void return_void() {}
+      void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+  };
+
+  /**
+   * @struct TaskAwaiter
+   * @brief Suspends a cook until the executor hands it a task.
+   */
+  struct TaskAwaiter {
+    CoroutineCookPool &pool;
+    uint32_t cook;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle);
+    CookingTask await_resume() const;
+  };
+
+  /**
+   * @struct TimerAwaiter
+   * @brief Suspends a cook until a steady_clock deadline.
+   */
+  struct TimerAwaiter {
+    CoroutineCookPool &pool;
+    std::chrono::steady_clock::time_point deadline;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle);
+    void await_resume() const noexcept {}
+  };
+
+  /**
+   * @struct Timer
+   * @brief A cook waiting in the timer heap.
+   */
+  struct Timer {
+    std::chrono::steady_clock::time_point deadline;
+    std::coroutine_handle<> handle;
+
+    bool operator>(const Timer &other) const {
+      return deadline > other.deadline;
+    }
+  };
+
+  /**
+   * @struct IdleCook
+   * @brief A cook waiting for a task.
+   */
+  struct IdleCook {
+    uint32_t cook;
+    std::coroutine_handle<> handle;
+  };
+
+  /**
+   * @brief The body of a cook: takes tasks and cooks them forever.
+   * @param cook The index of the cook.
+   * @return The coroutine of the cook.
+   */
+  CookRoutine cookLoop(uint32_t cook);
+
+  /**
+   * @brief The executor loop resuming cooks whose timer is due and handing
+   * submitted tasks to idle cooks.
+   * @param stopToken Token signalled when the pool is stopped.
+   */
+  void runExecutor(std::stop_token stopToken);
+
+  /**
+   * @brief Adds cooks, or retires idle cooks first and then busy ones once
+   * their pizza is done. Retired cooks are freed and their slots reused by
+   * the next cooks added. Runs on the executor thread.
+   * @param cookCount The new number of cooks.
+   */
+  void applyResize(uint32_t cookCount);
+
+  Callback m_callback;
+  double m_timeMultiplier;
+  std::vector<std::coroutine_handle<CookRoutine::promise_type>> m_routines;
+  std::vector<CookingTask> m_assignedTasks;
+  std::atomic<uint32_t> m_busyCooks{0};
+
+  // Only touched by the executor thread.
+  std::priority_queue<Timer, std::vector<Timer>, std::greater<>> m_timers;
+  std::deque<IdleCook> m_idleCooks;
+  std::deque<CookingTask> m_tasks;
+  std::vector<uint32_t> m_freeCooks; ///< Slots of retired cooks.
+  bool m_routinesStarted = false;
+  uint32_t m_activeCooks;
+  uint32_t m_cooksToRetire = 0;
+
+  std::mutex m_mutex;
+  std::condition_variable_any m_wakeup;
+  std::vector<CookingTask> m_submittedTasks;
+  std::optional<uint32_t> m_requestedCooks;
+
+  std::stop_source m_stopSource;
+  Core::Thread m_executor;
+};
+} // namespace Plazza::Kitchen
@@ -3,26 +3,26 @@
 #include "Core/Pizza.hpp"
 #include "Core/PizzaPacket.hpp"
 #include "Logger/Logger.hpp"
-#include <thread>
+#include <algorithm>
 
 namespace Plazza::Kitchen {
 Kitchen::Kitchen(uint32_t id, uint32_t cookCount,
                  std::chrono::milliseconds restockInterval,
-                 double timeMultiplier)
-    : m_id(id), m_cooksCount(cookCount), m_timeMultiplier(timeMultiplier) {
-  m_stock = std::make_unique<Stock>(restockInterval);
-
-  m_cooks.reserve(m_cooksCount);
-  for (uint32_t i = 0; i < m_cooksCount; ++i) {
-    std::unique_ptr<Cook> cook = std::make_unique<Cook>(
-        i + 1, [this](const Core::Pizza &pizza) { onPizzaCompleted(pizza); },
-        m_timeMultiplier);
-    m_cooks.push_back(std::move(cook));
-  }
-
-  m_ipcManager =
-      std::make_unique<Communication::IPCManager>(m_id, false, m_cooksCount);
+                 double timeMultiplier, bool sharedDispatch,
+                 CookModel cookModel, Communication::Transport transport,
+                 uint32_t initialStock)
+    : m_id(id), m_cooksCount(cookCount), m_timeMultiplier(timeMultiplier),
+      m_sharedDispatch(sharedDispatch) {
+  m_stock = std::make_unique<Stock>(restockInterval, initialStock);
+  m_cookPool = CookPool::create(
+      cookModel, m_cooksCount,
+      [this](const CookingTask &task) { onPizzaCompleted(task); },
+      m_timeMultiplier);
+
+  m_ipcManager = std::make_unique<Communication::IPCManager>(
+      m_id, false, m_cooksCount, transport);
   setupMessageHandlers();
+  m_loop = std::make_unique<Core::EventLoop>();
   m_lastActivity = std::chrono::steady_clock::now();
 }
 
@@ -31,37 +31,29 @@ Kitchen::~Kitchen() { stop(); }
 void Kitchen::run() {
   try {
     m_ipcManager->connectToReception();
-    m_stock->startRestock();
-
-    for (auto &cook : m_cooks) {
-      cook->start();
+    if (m_sharedDispatch) {
+      m_orderTable = std::make_unique<Communication::SharedOrderTable>(
+          Communication::SharedOrderTable::DEFAULT_NAME, false);
     }
 
-    m_ipcManager->startListening();
-
-    LOG_INFO("Kitchen " + std::to_string(m_id) + " started with " +
-             std::to_string(m_cooksCount) + " cooks");
-
-    auto lastHeartbeat = std::chrono::steady_clock::now();
-
-    while (m_running) {
-      auto now = std::chrono::steady_clock::now();
+    m_cookPool->start();
+    m_ipcManager->attach(*m_loop);
 
-      if (now - lastHeartbeat >= HEARTBEAT_INTERVAL) {
-        sendHeartbeat();
-        lastHeartbeat = now;
-      }
+    auto now = std::chrono::steady_clock::now();
+    int heartbeatTimer = m_loop->createTimer([this]() { onHeartbeatTick(); });
+    m_loop->setTimer(heartbeatTimer, now + HEARTBEAT_INTERVAL,
+                     HEARTBEAT_INTERVAL);
+    m_restockTimer = m_loop->createTimer([this]() { processPendingOrders(); });
 
-      processPendingOrders();
+    if (m_orderTable) {
+      int claimTimer = m_loop->createTimer([this]() { claimSharedOrders(); });
+      m_loop->setTimer(claimTimer, now + CLAIM_INTERVAL, CLAIM_INTERVAL);
+    }
 
-      if (now - m_lastActivity >= TIMEOUT) {
-        LOG_INFO("Kitchen " + std::to_string(m_id) + " timed out due to " +
-                 "inactivity");
-        break;
-      }
+    LOG_INFO("Kitchen " + std::to_string(m_id) + " started with " +
+             std::to_string(m_cooksCount) + " cooks");
 
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
+    m_loop->run();
 
   } catch (const std::exception &e) {
     LOG_ERROR("Kitchen " + std::to_string(m_id) + " error: " + e.what());
@@ -71,18 +63,12 @@ void Kitchen::run() {
 }
 
 void Kitchen::stop() {
-  m_running = false;
-
-  if (m_ipcManager) {
-    m_ipcManager->stopListening();
+  if (m_loop) {
+    m_loop->stop();
   }
 
-  for (auto &cook : m_cooks) {
-    cook->stop();
-  }
-
-  if (m_stock) {
-    m_stock->stopRestock();
+  if (m_cookPool) {
+    m_cookPool->stop();
   }
 }
 
@@ -99,11 +85,27 @@ void Kitchen::setupMessageHandlers() {
         handleStatusRequest(message);
       });
 
+  m_ipcManager->setMessageHandler(
+      Communication::Message::MessageType::RECALL_ORDERS,
+      [this](const Communication::Message &message) {
+        handleRecallOrders(message);
+      });
+
   m_ipcManager->setMessageHandler(
       Communication::Message::MessageType::SHUTDOWN,
       [this](const Communication::Message &message) {
         handleShutdown(message);
       });
+
+  m_ipcManager->setMessageHandler(
+      Communication::Message::MessageType::DRAIN,
+      [this](const Communication::Message &message) { handleDrain(message); });
+
+  m_ipcManager->setMessageHandler(
+      Communication::Message::MessageType::RESIZE_COOKS,
+      [this](const Communication::Message &message) {
+        handleResizeCooks(message);
+      });
 }
 
 void Kitchen::handlePizzaOrder(const Communication::Message &message) {
@@ -114,31 +116,10 @@ void Kitchen::handlePizzaOrder(const Communication::Message &message) {
     Communication::PizzaOrder order;
     order.unpack(object);
 
-    std::unique_ptr<Core::Pizza> pizza =
-        Core::Pizza::createPizza(order.type, order.size);
-    auto &ingredients = pizza->getIngredients();
-
-    bool assigned = m_stock->consumeIngredients(ingredients, [&]() -> bool {
-      for (auto &cook : m_cooks) {
-        if (cook->assignPizza(*pizza)) {
-          ++m_pendingPizzas;
-          m_lastActivity = std::chrono::steady_clock::now();
-          LOG_INFO("Kitchen " + std::to_string(m_id) + " accepted pizza " +
-                   "order: " + Core::toString(pizza->getType()) + " " +
-                   Core::toString(pizza->getSize()));
-          return true;
-        }
-      }
-      return false;
-    });
-
-    if (!assigned) {
-      std::lock_guard<std::mutex> lockGuard(m_pendingMutex);
-      m_pendingOrders.emplace_back(order);
-      LOG_INFO("Kitchen " + std::to_string(m_id) +
-               " queued pizza order (no cook/stock available): " +
-               Core::toString(order.type) + " " + Core::toString(order.size));
-    }
+    LOG_INFO("Kitchen " + std::to_string(m_id) + " received pizza order: " +
+             Core::toString(order.type) + " " + Core::toString(order.size));
+    enqueueOrder(order);
+    processPendingOrders();
 
   } catch (const std::exception &e) {
     LOG_ERROR("Error handling pizza order in kitchen " + std::to_string(m_id) +
@@ -152,41 +133,150 @@ void Kitchen::handleStatusRequest(
   m_lastActivity = std::chrono::steady_clock::now();
 }
 
+void Kitchen::handleRecallOrders(const Communication::Message &message) {
+  try {
+    Core::OpaqueObject object =
+        Core::OpaqueObject::fromString(message.getPayload());
+
+    uint32_t count = 0;
+    object.unpack(count);
+
+    uint32_t handedBack = 0;
+    std::lock_guard<std::mutex> lockGuard(m_pendingMutex);
+    while (handedBack < count && !m_pendingOrders.empty()) {
+      auto latest = std::prev(m_pendingOrders.end());
+      if (!handOrderBack(latest->order)) {
+        break;
+      }
+      erasePending(latest);
+      ++handedBack;
+    }
+
+    if (handedBack > 0) {
+      LOG_INFO("Kitchen " + std::to_string(m_id) + " handed back " +
+               std::to_string(handedBack) + " pending orders on recall");
+    }
+  } catch (const std::exception &e) {
+    LOG_ERROR("Error handling recall in kitchen " + std::to_string(m_id) +
+              ": " + e.what());
+  }
+}
+
 void Kitchen::handleShutdown(
     [[maybe_unused]] const Communication::Message &message) {
   LOG_INFO("Kitchen " + std::to_string(m_id) + " received shutdown signal");
-  m_running = false;
+  m_loop->stop();
+}
+
+void Kitchen::handleDrain(
+    [[maybe_unused]] const Communication::Message &message) {
+  LOG_INFO("Kitchen " + std::to_string(m_id) + " draining");
+  m_draining = true;
+  if (m_orderTable) {
+    claimSharedOrders();
+  }
+  finishDrainIfIdle();
+}
+
+void Kitchen::handleResizeCooks(const Communication::Message &message) {
+  try {
+    Core::OpaqueObject object =
+        Core::OpaqueObject::fromString(message.getPayload());
+
+    uint32_t cookCount = 0;
+    object.unpack(cookCount);
+    if (cookCount == 0 || cookCount == m_cooksCount) {
+      return;
+    }
+
+    LOG_INFO("Kitchen " + std::to_string(m_id) + " resizing from " +
+             std::to_string(m_cooksCount) + " to " +
+             std::to_string(cookCount) + " cooks");
+    m_cookPool->resize(cookCount);
+    m_cooksCount = cookCount;
+    m_lastActivity = std::chrono::steady_clock::now();
+
+    processPendingOrders();
+    sendStatus();
+  } catch (const std::exception &e) {
+    LOG_ERROR("Error handling resize in kitchen " + std::to_string(m_id) +
+              ": " + e.what());
+  }
+}
+
+void Kitchen::finishDrainIfIdle() {
+  if (!m_draining || !isIdle()) {
+    return;
+  }
+
+  try {
+    m_ipcManager->sendToReception(Communication::Message::create(
+        Communication::Message::MessageType::DRAINED, m_id));
+  } catch (const std::exception &e) {
+    LOG_ERROR("Kitchen " + std::to_string(m_id) +
+              " failed to report drain: " + e.what());
+  }
+  m_loop->stop();
 }
 
-void Kitchen::onPizzaCompleted(const Core::Pizza &pizza) {
+void Kitchen::onPizzaCompleted(const CookingTask &task) {
+  if (m_orderTable &&
+      task.tableSlot != Communication::SharedOrderTable::NO_SLOT) {
+    m_orderTable->complete(task.tableSlot, task.tableTicket);
+  }
+
   Communication::PizzaCompletion completion;
-  completion.pizza.setPizza(pizza);
+  completion.pizza.setPizza(task.pizza);
+  completion.pizza.setOrderId(task.order.orderId);
   completion.pizza.setKitchenId(m_id);
   completion.completionTime = std::chrono::steady_clock::now();
+  completion.deadline = task.order.deadline;
 
   Core::OpaqueObject object = completion.pack();
 
-  Communication::Message message{
+  Communication::Message message = Communication::Message::create(
       Communication::Message::MessageType::PIZZA_COMPLETED, m_id,
-      static_cast<uint32_t>(
-          std::chrono::duration_cast<std::chrono::seconds>(
-              std::chrono::system_clock::now().time_since_epoch())
-              .count()),
-      object.toString()};
+      object.toString());
 
   m_ipcManager->sendToReception(message);
   m_pendingPizzas--;
   m_lastActivity = std::chrono::steady_clock::now();
+
+  if (!m_schedulePosted.exchange(true)) {
+    m_loop->post([this]() {
+      m_schedulePosted = false;
+      processPendingOrders();
+      if (m_orderTable) {
+        claimSharedOrders();
+      }
+      finishDrainIfIdle();
+    });
+  }
+}
+
+void Kitchen::onHeartbeatTick() {
+  sendHeartbeat();
+  if (m_draining) {
+    processPendingOrders();
+    finishDrainIfIdle();
+  } else {
+    if (isIdle()) {
+      sendWorkRequest();
+    }
+    processPendingOrders();
+    handBackStarvedOrders();
+  }
+
+  if (std::chrono::steady_clock::now() - m_lastActivity >= TIMEOUT) {
+    LOG_INFO("Kitchen " + std::to_string(m_id) + " timed out due to " +
+             "inactivity");
+    m_loop->stop();
+  }
 }
 
 void Kitchen::sendHeartbeat() {
-  Communication::Message message{
-      Communication::Message::MessageType::HEARTBEAT, m_id,
-      static_cast<uint32_t>(
-          std::chrono::duration_cast<std::chrono::seconds>(
-              std::chrono::system_clock::now().time_since_epoch())
-              .count()),
-      ""};
+  Communication::Message message = Communication::Message::create(
+      Communication::Message::MessageType::HEARTBEAT, m_id);
 
   try {
     m_ipcManager->sendToReception(message);
@@ -197,16 +287,9 @@ void Kitchen::sendHeartbeat() {
 }
 
 void Kitchen::sendStatus() {
-  uint32_t busyCooks = 0;
-  for (const auto &cook : m_cooks) {
-    if (cook->isBusy()) {
-      busyCooks++;
-    }
-  }
-
   Communication::KitchenStatus status;
   status.kitchenId = m_id;
-  status.busyCooks = busyCooks;
+  status.busyCooks = m_cookPool->busyCooks();
   status.totalCooks = m_cooksCount;
   status.pendingPizzas = m_pendingPizzas;
 
@@ -218,13 +301,9 @@ void Kitchen::sendStatus() {
 
   Core::OpaqueObject object = status.pack();
 
-  Communication::Message message{
+  Communication::Message message = Communication::Message::create(
       Communication::Message::MessageType::STATUS_RESPONSE, m_id,
-      static_cast<uint32_t>(
-          std::chrono::duration_cast<std::chrono::seconds>(
-              std::chrono::system_clock::now().time_since_epoch())
-              .count()),
-      object.toString()};
+      object.toString());
 
   try {
     m_ipcManager->sendToReception(message);
@@ -234,33 +313,274 @@ void Kitchen::sendStatus() {
   }
 }
 
-void Kitchen::processPendingOrders() {
+void Kitchen::sendWorkRequest() {
+  Communication::Message message = Communication::Message::create(
+      Communication::Message::MessageType::WORK_REQUEST, m_id);
+
+  try {
+    m_ipcManager->sendToReception(message);
+  } catch (const std::exception &e) {
+    LOG_ERROR("Kitchen " + std::to_string(m_id) +
+              " failed to request work: " + e.what());
+  }
+}
+
+bool Kitchen::handOrderBack(const Communication::PizzaOrder &order) {
+  Communication::Message message = Communication::Message::create(
+      Communication::Message::MessageType::ORDER_HANDBACK, m_id,
+      order.pack().toString());
+
+  try {
+    m_ipcManager->sendToReception(message);
+    return true;
+  } catch (const std::exception &e) {
+    LOG_ERROR("Kitchen " + std::to_string(m_id) +
+              " failed to hand back order: " + e.what());
+    return false;
+  }
+}
+
+void Kitchen::handBackStarvedOrders() {
+  if (!hasIdleCook()) {
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
   std::lock_guard<std::mutex> lg(m_pendingMutex);
   auto it = m_pendingOrders.begin();
   while (it != m_pendingOrders.end()) {
-    auto &order = *it;
-    auto pizza = Core::Pizza::createPizza(order.type, order.size);
-    auto &ingredients = pizza->getIngredients();
-
-    bool assigned = m_stock->consumeIngredients(ingredients, [&]() -> bool {
-      for (auto &cook : m_cooks) {
-        if (cook->assignPizza(*pizza)) {
-          ++m_pendingPizzas;
-          m_lastActivity = std::chrono::steady_clock::now();
-          LOG_INFO("Kitchen " + std::to_string(m_id) + " assigned pending " +
-                   "pizza order: " + Core::toString(pizza->getType()) + " " +
-                   Core::toString(pizza->getSize()));
-          return true;
-        }
-      }
-      return false;
-    });
-
-    if (assigned) {
-      it = m_pendingOrders.erase(it);
+    if (now - it->queuedAt >= HANDBACK_DELAY && handOrderBack(it->order)) {
+      LOG_INFO("Kitchen " + std::to_string(m_id) +
+               " handed back starved order: " +
+               Core::toString(it->order.type) + " " +
+               Core::toString(it->order.size));
+      it = erasePending(it);
     } else {
       ++it;
     }
   }
 }
+
+bool Kitchen::isIdle() const {
+  if (m_pendingPizzas > 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lg(m_pendingMutex);
+  return m_pendingOrders.empty();
+}
+
+bool Kitchen::startOrder(const Communication::PizzaOrder &order,
+                         uint32_t tableSlot, uint64_t tableTicket) {
+  Core::Pizza pizza = Core::Pizza::createPizza(order.type, order.size);
+  CookingTask task{order, pizza, tableSlot, tableTicket};
+
+  return m_stock->consumeIngredients(pizza.getIngredients(), [&]() -> bool {
+    uint32_t queued = m_pendingPizzas.load();
+    do {
+      if (queued >= m_cooksCount * QUEUED_PIZZAS_PER_COOK) {
+        return false;
+      }
+    } while (!m_pendingPizzas.compare_exchange_weak(queued, queued + 1));
+
+    m_cookPool->submit(task);
+    m_lastActivity = std::chrono::steady_clock::now();
+    return true;
+  });
+}
+
+void Kitchen::claimSharedOrders() {
+  if (m_orderTable->occupied() > 0) {
+    m_lastActivity = std::chrono::steady_clock::now();
+  }
+
+  {
+    std::lock_guard<std::mutex> lg(m_pendingMutex);
+    if (!m_pendingOrders.empty()) {
+      return;
+    }
+  }
+
+  while (hasIdleCook()) {
+    std::optional<Communication::ClaimedOrder> claimed = m_orderTable->claim(
+        m_id, [this](const Communication::PizzaOrder &order) {
+          return m_stock->hasIngredients(
+              Core::recipeOf(order.type).ingredients);
+        });
+    if (!claimed) {
+      return;
+    }
+
+    if (!startOrder(claimed->order, claimed->slot, claimed->ticket)) {
+      m_orderTable->release(claimed->slot, claimed->ticket);
+      return;
+    }
+    LOG_INFO("Kitchen " + std::to_string(m_id) + " claimed pizza order: " +
+             Core::toString(claimed->order.type) + " " +
+             Core::toString(claimed->order.size));
+  }
+}
+
+bool Kitchen::hasIdleCook() const { return m_pendingPizzas < m_cooksCount; }
+
+void Kitchen::enqueueOrder(const Communication::PizzaOrder &order) {
+  auto now = std::chrono::steady_clock::now();
+  Core::Pizza pizza = Core::Pizza::createPizza(order.type, order.size);
+  std::chrono::steady_clock::time_point dueAt;
+
+  if (order.deadline != 0) {
+    dueAt = std::chrono::steady_clock::time_point(
+        std::chrono::nanoseconds(order.deadline));
+  } else {
+    double cookingTime = pizza.getCookingTime(m_timeMultiplier);
+    dueAt = now + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::duration<double>(DEFAULT_DEADLINE_SLACK *
+                                                    cookingTime));
+  }
+
+  std::lock_guard<std::mutex> lg(m_pendingMutex);
+  auto it = m_pendingOrders.insert({order, now, dueAt, m_pendingSequence++,
+                                    pizza.getIngredients()})
+                .first;
+  m_buckets[PendingOrder::UNEVALUATED].insert(it);
+}
+
+std::set<PendingOrder>::iterator
+Kitchen::erasePending(std::set<PendingOrder>::iterator it) {
+  m_buckets[it->blockedOn].erase(it);
+  return m_pendingOrders.erase(it);
+}
+
+void Kitchen::moveToBucket(PendingRef it, uint32_t bucket) {
+  m_buckets[it->blockedOn].erase(it);
+  it->blockedOn = bucket;
+  m_buckets[bucket].insert(it);
+}
+
+bool Kitchen::isBucketBlocked(uint32_t bucket, Core::IngredientLanes stock,
+                              Core::IngredientLanes held) const {
+  if (bucket == PendingOrder::UNEVALUATED) {
+    return false;
+  }
+  if (bucket == PendingOrder::QUEUE_FULL) {
+    return !hasQueueSpace();
+  }
+  auto ingredient = static_cast<Core::Ingredient>(bucket);
+  return Core::laneCount(stock, ingredient) == 0 ||
+         Core::laneCount(held, ingredient) > 0;
+}
+
+uint32_t Kitchen::blockingBucket(Core::IngredientLanes need,
+                                 Core::IngredientLanes stock,
+                                 Core::IngredientLanes held) {
+  for (uint32_t i = 0; i < Core::INGREDIENT_COUNT; ++i) {
+    auto ingredient = static_cast<Core::Ingredient>(i);
+    uint32_t needed = Core::laneCount(need, ingredient);
+    if (needed > 0 && (Core::laneCount(stock, ingredient) < needed ||
+                       Core::laneCount(held, ingredient) > 0)) {
+      return i;
+    }
+  }
+  return PendingOrder::QUEUE_FULL;
+}
+
+bool Kitchen::hasQueueSpace() const {
+  return m_pendingPizzas < m_cooksCount * QUEUED_PIZZAS_PER_COOK;
+}
+
+void Kitchen::processPendingOrders() {
+  std::lock_guard<std::mutex> lg(m_pendingMutex);
+  Core::IngredientLanes stock = m_stock->getLanes();
+  auto now = std::chrono::steady_clock::now();
+
+  // Overdue orders blocked by the stock or the queue keep holding their
+  // ingredients, whatever the scan does.
+  Core::IngredientLanes heldIngredients = 0;
+  for (uint32_t bucket = 0; bucket < PendingOrder::BUCKET_COUNT; ++bucket) {
+    if (!isBucketBlocked(bucket, stock, 0)) {
+      continue;
+    }
+    for (PendingRef it : m_buckets[bucket]) {
+      if (it->dueAt > now) {
+        break;
+      }
+      heldIngredients |= it->need;
+    }
+  }
+
+  // Overdue orders of blocked buckets are scanned too, as they hold back
+  // their ingredients from the orders due after them.
+  bool unblocked = false;
+  m_candidates.clear();
+  for (uint32_t bucket = 0; bucket < PendingOrder::BUCKET_COUNT; ++bucket) {
+    const auto &orders = m_buckets[bucket];
+    if (!isBucketBlocked(bucket, stock, heldIngredients)) {
+      unblocked |= !orders.empty();
+      m_candidates.insert(m_candidates.end(), orders.begin(), orders.end());
+      continue;
+    }
+    bool onlyHeld = !isBucketBlocked(bucket, stock, 0);
+    for (PendingRef it : orders) {
+      if (it->dueAt > now) {
+        break;
+      }
+      unblocked |= onlyHeld;
+      m_candidates.push_back(it);
+    }
+  }
+  if (!unblocked) {
+    scheduleRestockWakeup();
+    return;
+  }
+  std::sort(m_candidates.begin(), m_candidates.end(), PendingRefLess{});
+
+  m_pendingNeeds.clear();
+  for (PendingRef it : m_candidates) {
+    m_pendingNeeds.push_back(it->need);
+  }
+  m_feasibleOrders.resize((m_pendingNeeds.size() + 63) / 64);
+  Core::feasibleMask(stock, m_pendingNeeds.data(), m_pendingNeeds.size(),
+                     m_feasibleOrders.data());
+
+  heldIngredients = 0;
+  for (std::size_t index = 0; index < m_candidates.size(); ++index) {
+    PendingRef it = m_candidates[index];
+    const auto &order = it->order;
+    bool feasible = (m_feasibleOrders[index / 64] >> (index % 64)) & 1;
+
+    if (feasible && !isBucketBlocked(it->blockedOn, stock, heldIngredients) &&
+        !Core::lanesOverlap(it->need, heldIngredients) && startOrder(order)) {
+      LOG_INFO("Kitchen " + std::to_string(m_id) + " started pizza order: " +
+               Core::toString(order.type) + " " + Core::toString(order.size));
+      erasePending(it);
+      stock = m_stock->getLanes();
+      continue;
+    }
+
+    if (it->blockedOn == PendingOrder::UNEVALUATED ||
+        !isBucketBlocked(it->blockedOn, stock, heldIngredients)) {
+      moveToBucket(it, blockingBucket(it->need, stock, heldIngredients));
+    }
+    if (now >= it->dueAt) {
+      heldIngredients |= it->need;
+    }
+  }
+  scheduleRestockWakeup();
+}
+
+void Kitchen::scheduleRestockWakeup() {
+  if (m_restockTimer == -1) {
+    return;
+  }
+
+  bool waitsOnIngredients =
+      std::any_of(m_buckets.begin(), m_buckets.begin() + Core::INGREDIENT_COUNT,
+                  [](const auto &orders) { return !orders.empty(); });
+  auto nextRestock = m_stock->nextRestockTime();
+
+  if (waitsOnIngredients && nextRestock > std::chrono::steady_clock::now()) {
+    m_loop->setTimer(m_restockTimer, nextRestock);
+  } else {
+    m_loop->cancelTimer(m_restockTimer);
+  }
+}
 } // namespace Plazza::Kitchen
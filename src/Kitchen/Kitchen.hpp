@@ -7,14 +7,55 @@
 
 #include "Communication/IPCManager.hpp"
 #include "Communication/Serialization.hpp"
+#include "Communication/SharedOrderTable.hpp"
+#include "Core/EventLoop.hpp"
+#include "Core/IngredientLanes.hpp"
 #include "Kitchen/Cook.hpp"
+#include "Kitchen/CookPool.hpp"
 #include "Kitchen/Stock.hpp"
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <set>
 #include <vector>
 
 namespace Plazza::Kitchen {
+/**
+ * @struct PendingOrder
+ * @brief A pizza order waiting in the kitchen for a cook or ingredients.
+ * Pending orders are ordered earliest deadline first.
+ */
+struct PendingOrder {
+  /**
+   * @brief Bucket of an order that could not start because the work queue
+   * was full. Buckets below it are the ordinals of the missing or held
+   * ingredient.
+   */
+  static constexpr uint32_t QUEUE_FULL = Core::INGREDIENT_COUNT;
+
+  /**
+   * @brief Bucket of an order that was not tried since it arrived.
+   */
+  static constexpr uint32_t UNEVALUATED = QUEUE_FULL + 1;
+
+  static constexpr uint32_t BUCKET_COUNT = UNEVALUATED + 1;
+
+  Communication::PizzaOrder order;
+  std::chrono::steady_clock::time_point queuedAt;
+  std::chrono::steady_clock::time_point dueAt;
+  uint64_t sequence;
+  Core::IngredientLanes need;
+  mutable uint32_t blockedOn = UNEVALUATED; ///< Not part of the ordering.
+
+  bool operator<(const PendingOrder &other) const {
+    if (dueAt != other.dueAt) {
+      return dueAt < other.dueAt;
+    }
+    return sequence < other.sequence;
+  }
+};
+
 /**
  * @class Kitchen
  * @brief Manages a kitchen with multiple cooks.
@@ -28,9 +69,19 @@ public:
    * @param restockInterval Interval for stock replenishment.
    * @param timeMultiplier Multiplier for cooking time to simulate different
    * cooking speeds.
+   * @param sharedDispatch If true, the kitchen also claims orders from the
+   * shared order table.
+   * @param cookModel How the cooks are run.
+   * @param transport How the kitchen talks to the reception.
+   * @param initialStock Units of each ingredient at opening.
    */
   Kitchen(uint32_t id, uint32_t cookCount,
-          std::chrono::milliseconds restockInterval, double timeMultiplier);
+          std::chrono::milliseconds restockInterval, double timeMultiplier,
+          bool sharedDispatch = false,
+          CookModel cookModel = CookModel::Threads,
+          Communication::Transport transport =
+              Communication::Transport::MessageQueue,
+          uint32_t initialStock = Stock::INITIAL_STOCK);
 
   /**
    * @brief Destructor that stops the kitchen.
@@ -39,14 +90,16 @@ public:
 
   /**
    * @brief Starts the kitchen operations.
-   * This method connects to the reception, starts stock replenishment, and
-   * initializes cooks.
+   * This method connects to the reception, starts the cooks and runs the
+   * kitchen event loop until shutdown or inactivity. The loop handles
+   * messages, heartbeats and restocks, so the cooks are the only other
+   * threads.
    */
   void run();
 
   /**
    * @brief Stops the kitchen operations.
-   * This method stops all cooks, stock replenishment, and IPC communication.
+   * This method stops all cooks and IPC communication.
    */
   void stop();
 
@@ -68,17 +121,60 @@ private:
    */
   void handleStatusRequest(const Communication::Message &message);
 
+  /**
+   * @brief Handles recall messages by handing pending orders back to the
+   * reception.
+   * @param message The received message containing the number of orders to
+   * hand back.
+   */
+  void handleRecallOrders(const Communication::Message &message);
+
   /**
    * @brief Handles shutdown messages.
    * @param message The received message indicating a shutdown request.
    */
   void handleShutdown(const Communication::Message &message);
 
+  /**
+   * @brief Handles drain messages.
+   * The kitchen stops asking for work and handing orders back, finishes the
+   * orders it holds, then reports it is drained and stops.
+   * @param message The received message requesting a drain.
+   */
+  void handleDrain(const Communication::Message &message);
+
+  /**
+   * @brief Handles messages changing the number of cooks.
+   * The queue limit follows the new number of cooks, and the new status is
+   * sent so the reception routes by the new capacity.
+   * @param message The received message holding the number of cooks.
+   */
+  void handleResizeCooks(const Communication::Message &message);
+
+  /**
+   * @brief Reports the kitchen drained and stops it, once draining and idle.
+   */
+  void finishDrainIfIdle();
+
   /**
    * @brief Callback function called when a pizza is completed.
-   * @param pizza The completed pizza.
+   * @param task The completed task.
+   */
+  void onPizzaCompleted(const CookingTask &task);
+
+  /**
+   * @brief Runs the periodic kitchen work on each heartbeat.
+   * Sends the heartbeat, asks for work when idle, hands back starved orders
+   * and stops the kitchen after TIMEOUT without activity.
+   */
+  void onHeartbeatTick();
+
+  /**
+   * @brief Arms the restock timer while orders wait on ingredients.
+   * The timer is disarmed when no order waits on an ingredient, so an idle
+   * kitchen is never woken up by restocks.
    */
-  void onPizzaCompleted(const Core::Pizza &pizza);
+  void scheduleRestockWakeup();
 
   /**
    * @brief Sends a heartbeat message to the reception.
@@ -90,28 +186,168 @@ private:
    */
   void sendStatus();
 
+  /**
+   * @brief Asks the reception for work when the kitchen is idle.
+   */
+  void sendWorkRequest();
+
+  /**
+   * @brief Returns a queued order to the reception so it can be re-routed.
+   * @param order The order to hand back.
+   * @return True if the order was sent back, false otherwise.
+   */
+  bool handOrderBack(const Communication::PizzaOrder &order);
+
+  /**
+   * @brief Hands back orders that waited too long while cooks were idle.
+   * Such orders are blocked on ingredients, another kitchen may cook them
+   * sooner.
+   */
+  void handBackStarvedOrders();
+
+  /**
+   * @brief Reserves the ingredients of an order and queues it for the cooks.
+   * @param order The order to start.
+   * @param tableSlot The order table slot the order was claimed from, if any.
+   * @param tableTicket The ticket of the order table claim, if any.
+   * @return True if the order was queued, false if the work queue is full or
+   * an ingredient is missing.
+   */
+  bool startOrder(const Communication::PizzaOrder &order,
+                  uint32_t tableSlot = Communication::SharedOrderTable::NO_SLOT,
+                  uint64_t tableTicket = 0);
+
+  /**
+   * @brief Claims orders from the shared order table while cooks are free.
+   */
+  void claimSharedOrders();
+
+  /**
+   * @brief Checks if at least one cook has no pizza to cook.
+   * @return True if fewer pizzas are queued or cooking than there are cooks,
+   * false otherwise.
+   */
+  [[nodiscard]] bool hasIdleCook() const;
+
+  /**
+   * @brief Checks if the kitchen has nothing to cook.
+   * @return True if no pizza is queued or cooking and no order is pending,
+   * false otherwise.
+   */
+  [[nodiscard]] bool isIdle() const;
+
+  /**
+   * @brief Adds an order to the pending set.
+   * Orders without a deadline are due DEFAULT_DEADLINE_SLACK times their
+   * cooking time after arrival.
+   * @param order The order to add.
+   */
+  void enqueueOrder(const Communication::PizzaOrder &order);
+
+  /**
+   * @brief Removes an order from the pending set and its bucket.
+   * @param it The pending order to remove.
+   * @return The iterator following the removed order.
+   */
+  std::set<PendingOrder>::iterator
+  erasePending(std::set<PendingOrder>::iterator it);
+
+  /**
+   * @brief Moves a pending order to another bucket.
+   * @param it The pending order.
+   * @param bucket The bucket it is now blocked on.
+   */
+  void moveToBucket(std::set<PendingOrder>::const_iterator it,
+                    uint32_t bucket);
+
+  /**
+   * @brief Checks if a bucket is still blocked.
+   * @param bucket The bucket to check.
+   * @param stock The current stock.
+   * @param held The ingredients held back for overdue orders, which block
+   * the bucket of a held ingredient even when it is in stock.
+   * @return True if orders of the bucket cannot start yet, false otherwise.
+   */
+  [[nodiscard]] bool isBucketBlocked(uint32_t bucket,
+                                     Core::IngredientLanes stock,
+                                     Core::IngredientLanes held) const;
+
+  /**
+   * @brief Finds the bucket of an order that could not start.
+   * @param need The ingredients of the order.
+   * @param stock The current stock.
+   * @param held The ingredients held back for overdue orders.
+   * @return The first missing or held ingredient, or QUEUE_FULL if the stock
+   * covers the order.
+   */
+  [[nodiscard]] static uint32_t blockingBucket(Core::IngredientLanes need,
+                                               Core::IngredientLanes stock,
+                                               Core::IngredientLanes held);
+
+  /**
+   * @brief Checks if the work queue can take another pizza.
+   * @return True if the queue is not full, false otherwise.
+   */
+  [[nodiscard]] bool hasQueueSpace() const;
+
   /**
    * @brief Processes pending pizza orders.
-   * This method checks for pending orders and assigns them to available cooks.
+   * Pending orders are bucketed by what blocked them: a missing or held
+   * ingredient, or a full work queue. Nothing is scanned until a new order
+   * arrives or a restock or completed pizza unblocks a non-empty bucket, and
+   * then only the orders of unblocked buckets are retried, along with the
+   * overdue orders whose ingredients are held back. The stock is checked
+   * against their recipes in one batched feasibleMask call before the scan.
+   * Orders start earliest deadline first. Once an order is overdue and cannot
+   * start, later orders may not take any of its ingredients, so it cannot be
+   * overtaken forever.
    */
   void processPendingOrders();
 
 private:
   static constexpr std::chrono::seconds TIMEOUT{5};
   static constexpr std::chrono::seconds HEARTBEAT_INTERVAL{1};
+  static constexpr std::chrono::seconds HANDBACK_DELAY{2};
+  static constexpr std::chrono::milliseconds CLAIM_INTERVAL{100};
+  static constexpr double DEFAULT_DEADLINE_SLACK = 4.0;
+  static constexpr uint32_t QUEUED_PIZZAS_PER_COOK = 2;
+
+  using PendingRef = std::set<PendingOrder>::const_iterator;
+
+  /**
+   * @struct PendingRefLess
+   * @brief Orders references to pending orders like the orders themselves.
+   */
+  struct PendingRefLess {
+    bool operator()(PendingRef lhs, PendingRef rhs) const {
+      return *lhs < *rhs;
+    }
+  };
 
   uint32_t m_id;
   uint32_t m_cooksCount;
   double m_timeMultiplier;
-  std::vector<std::unique_ptr<Cook>> m_cooks;
+  bool m_sharedDispatch;
+  std::unique_ptr<CookPool> m_cookPool;
   std::unique_ptr<Stock> m_stock;
   std::unique_ptr<Communication::IPCManager> m_ipcManager;
+  std::unique_ptr<Communication::SharedOrderTable> m_orderTable;
 
   std::atomic<uint32_t> m_pendingPizzas{0};
-  std::atomic<bool> m_running{true};
+  std::unique_ptr<Core::EventLoop> m_loop;
+  int m_restockTimer = -1;
+  std::atomic<bool> m_schedulePosted{false};
   std::chrono::steady_clock::time_point m_lastActivity;
+  bool m_draining = false;
 
   mutable std::mutex m_pendingMutex;
-  std::deque<Communication::PizzaOrder> m_pendingOrders;
+  std::set<PendingOrder> m_pendingOrders;
+  /// The pending orders of each bucket, earliest deadline first.
+  std::array<std::set<PendingRef, PendingRefLess>, PendingOrder::BUCKET_COUNT>
+      m_buckets;
+  std::vector<PendingRef> m_candidates; ///< Orders retried by a scan.
+  std::vector<Core::IngredientLanes> m_pendingNeeds;
+  std::vector<uint64_t> m_feasibleOrders;
+  uint64_t m_pendingSequence = 0;
 };
 } // namespace Plazza::Kitchen
@@ -1,75 +1,89 @@
 #include "Kitchen/Stock.hpp"
+#include <algorithm>
 #include <chrono>
 
 namespace Plazza::Kitchen {
-Stock::Stock(std::chrono::milliseconds restockTime)
-    : m_restockTime(restockTime) {
-  m_stock[Core::Ingredient::Dough] = 5;
-  m_stock[Core::Ingredient::Tomato] = 5;
-  m_stock[Core::Ingredient::Gruyere] = 5;
-  m_stock[Core::Ingredient::Ham] = 5;
-  m_stock[Core::Ingredient::Mushrooms] = 5;
-  m_stock[Core::Ingredient::Steak] = 5;
-  m_stock[Core::Ingredient::Eggplant] = 5;
-  m_stock[Core::Ingredient::GoatCheese] = 5;
-  m_stock[Core::Ingredient::ChiefLove] = 5;
-}
-
-Stock::~Stock() { stopRestock(); }
+Stock::Stock(std::chrono::milliseconds restockTime, uint32_t initialStock)
+    : m_stock(Core::broadcastLanes(
+          std::min<uint64_t>(initialStock, Core::LANE_MAX))),
+      m_restockTime(restockTime),
+      m_lastRestock(
+          std::chrono::steady_clock::now().time_since_epoch().count()) {}
 
-bool Stock::consumeIngredients(const std::vector<Core::Ingredient> &ingredients,
+bool Stock::consumeIngredients(Core::IngredientLanes ingredients,
                                std::function<bool()> reservation) {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  restock();
+  Core::IngredientLanes stock = m_stock.load();
 
-  for (auto &ingredient : ingredients) {
-    if (m_stock[ingredient] == 0) {
+  do {
+    if (!Core::lanesCover(stock, ingredients)) {
       return false;
     }
-  }
-
-  for (auto &ingredient : ingredients) {
-    --m_stock[ingredient];
-  }
+  } while (!m_stock.compare_exchange_weak(
+      stock, Core::subtractLanes(stock, ingredients)));
 
   bool isReservationSuccessful = reservation();
   if (!isReservationSuccessful) {
-    for (auto &ig : ingredients) {
-      ++m_stock[ig];
+    stock = m_stock.load();
+    while (!m_stock.compare_exchange_weak(
+        stock, Core::addLanesSaturated(stock, ingredients))) {
     }
   }
   return isReservationSuccessful;
 }
 
-std::map<Core::Ingredient, uint32_t> Stock::getStock() const {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  return m_stock;
+bool Stock::hasIngredients(Core::IngredientLanes ingredients) const {
+  restock();
+  return Core::lanesCover(m_stock.load(), ingredients);
 }
 
-void Stock::startRestock() {
-  m_shouldRestock = true;
-  m_thread.start([this]() { restock(); });
+Core::IngredientLanes Stock::getLanes() const {
+  restock();
+  return m_stock.load();
 }
 
-void Stock::stopRestock() {
-  m_shouldRestock = false;
-  if (m_thread.joinable()) {
-    m_thread.join();
+std::map<Core::Ingredient, uint32_t> Stock::getStock() const {
+  restock();
+  Core::IngredientLanes stock = m_stock.load();
+  std::map<Core::Ingredient, uint32_t> snapshot;
+
+  for (uint32_t i = 0; i < Core::INGREDIENT_COUNT; ++i) {
+    auto ingredient = static_cast<Core::Ingredient>(i);
+    snapshot[ingredient] = Core::laneCount(stock, ingredient);
   }
+  return snapshot;
+}
+
+std::chrono::steady_clock::time_point Stock::nextRestockTime() const {
+  std::chrono::steady_clock::time_point last(
+      std::chrono::steady_clock::duration(m_lastRestock.load()));
+  return last + m_restockTime;
 }
 
-void Stock::restock() {
-  while (m_shouldRestock) {
-    std::this_thread::sleep_for(m_restockTime);
+void Stock::restock() const {
+  if (m_restockTime.count() == 0) {
+    m_stock.store(Core::broadcastLanes(Core::LANE_MAX));
+    return;
+  }
 
-    if (!m_shouldRestock)
-      break;
+  auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    m_restockTime)
+                    .count();
+  auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+  auto last = m_lastRestock.load();
+  std::chrono::steady_clock::rep periods = 0;
 
-    {
-      std::lock_guard<std::mutex> lock(m_mutex);
-      for (auto &[ingredient, count] : m_stock) {
-        count++;
-      }
+  do {
+    periods = (now - last) / period;
+    if (periods <= 0) {
+      return;
     }
+  } while (!m_lastRestock.compare_exchange_weak(last, last + periods * period));
+
+  uint64_t units = std::min<uint64_t>(periods, Core::LANE_MAX);
+  Core::IngredientLanes stock = m_stock.load();
+  while (!m_stock.compare_exchange_weak(
+      stock, Core::addLanesSaturated(stock, Core::broadcastLanes(units)))) {
   }
 }
 } // namespace Plazza::Kitchen
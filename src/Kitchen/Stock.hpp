@@ -5,69 +5,84 @@
 
 #pragma once
 
+#include "Core/IngredientLanes.hpp"
 #include "Core/Pizza.hpp"
-#include "Core/Thread.hpp"
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <map>
-#include <mutex>
 
 namespace Plazza::Kitchen {
 /**
  * @class Stock
  * @brief Manage stock of ingredients in the kitchen.
+ * All counts live in one atomic word of ingredient lanes, so a recipe is
+ * reserved with a single compare-and-swap and reads see a consistent stock.
+ * Each ingredient is capped at Core::LANE_MAX.
  */
 class Stock {
 public:
-  /**
-   * @brief Constructs a Stock instance.
-   * @param restockTime Time to restock the stock.
-   */
-  Stock(std::chrono::milliseconds restockTime);
+  static constexpr uint32_t INITIAL_STOCK = 5;
 
   /**
-   * @brief Destructor that stops the restock thread.
+   * @brief Constructs a Stock instance.
+   * @param restockTime Time between two restocks.
+   * @param initialStock Units of each ingredient at opening, capped at
+   * Core::LANE_MAX.
    */
-  ~Stock();
+  Stock(std::chrono::milliseconds restockTime,
+        uint32_t initialStock = INITIAL_STOCK);
 
   /**
    * @brief Consumes ingredients from the stock.
+   * The ingredients are taken all at once before the reservation runs, and
+   * put back if it fails. No lock is held while the reservation runs.
    * @param ingredients The ingredients to consume.
-   * @return True if all ingredients were available and consumed, false
-   * otherwise.
+   * @param reservation Callback claiming whatever else the caller needs.
+   * @return True if all ingredients were available and the reservation
+   * succeeded, false otherwise.
    */
   [[nodiscard]] bool
-  consumeIngredients(const std::vector<Core::Ingredient> &ingredients,
+  consumeIngredients(Core::IngredientLanes ingredients,
                      std::function<bool()> reservation);
 
   /**
-   * @brief Gets the current stock of ingredients.
-   * @return A map of ingredients and their quantities.
+   * @brief Checks if the stock holds the given ingredients.
+   * @param ingredients The ingredients to look for.
+   * @return True if every ingredient is available, false otherwise.
    */
-  [[nodiscard]] std::map<Core::Ingredient, uint32_t> getStock() const;
+  [[nodiscard]] bool hasIngredients(Core::IngredientLanes ingredients) const;
 
   /**
-   * @brief Starts the restock thread.
+   * @brief Gets the current stock as packed ingredient lanes.
+   * @return The ingredient counts, read in a single load.
    */
-  void startRestock();
+  [[nodiscard]] Core::IngredientLanes getLanes() const;
 
   /**
-   * @brief Stops the restock thread.
-   * This method will stop the periodic restocking of ingredients.
+   * @brief Gets when the next restock is due.
+   * @return The time of the next restock. With a restock time of zero it is
+   * never in the future, as the stock is always full.
    */
-  void stopRestock();
+  [[nodiscard]] std::chrono::steady_clock::time_point nextRestockTime() const;
+
+  /**
+   * @brief Gets the current stock of ingredients.
+   * @return A map of ingredients and their quantities.
+   */
+  [[nodiscard]] std::map<Core::Ingredient, uint32_t> getStock() const;
 
 private:
   /**
-   * @brief The main restocking loop that periodically restocks the stock.
-   * This method runs in a separate thread and periodically restocks the stock.
+   * @brief Credits the restocks due since the last credited one.
+   * Restocking is derived from the clock on each access instead of running
+   * on a thread: every elapsed restock period adds one of each ingredient.
+   * A restock time of zero keeps the stock full.
    */
-  void restock();
+  void restock() const;
 
-  mutable std::mutex m_mutex;
-  std::map<Core::Ingredient, uint32_t> m_stock;
+  mutable std::atomic<Core::IngredientLanes> m_stock;
   std::chrono::milliseconds m_restockTime;
-  Core::Thread m_thread;
-  std::atomic<bool> m_shouldRestock{true};
+  mutable std::atomic<std::chrono::steady_clock::rep> m_lastRestock;
 };
 } // namespace Plazza::Kitchen
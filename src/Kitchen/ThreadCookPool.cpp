@@ -0,0 +1,66 @@
+#include "Kitchen/ThreadCookPool.hpp"
+
+namespace Plazza::Kitchen {
+ThreadCookPool::ThreadCookPool(uint32_t cookCount, Callback callback,
+                               double timeMultiplier)
+    : m_callback(std::move(callback)), m_timeMultiplier(timeMultiplier) {
+  m_cooks.reserve(cookCount);
+  resize(cookCount);
+}
+
+ThreadCookPool::~ThreadCookPool() { stop(); }
+
+void ThreadCookPool::start() {
+  m_started = true;
+  for (auto &cook : m_cooks) {
+    cook->start();
+  }
+}
+
+void ThreadCookPool::stop() {
+  m_started = false;
+  for (auto &cook : m_cooks) {
+    cook->stop();
+  }
+  m_retiredCooks.clear();
+}
+
+void ThreadCookPool::submit(const CookingTask &task) { m_workQueue.push(task); }
+
+void ThreadCookPool::resize(uint32_t cookCount) {
+  std::erase_if(m_retiredCooks, [](const std::unique_ptr<Cook> &cook) {
+    return cook->hasLeft();
+  });
+
+  while (m_cooks.size() < cookCount) {
+    m_cooks.push_back(std::make_unique<Cook>(m_nextCookId++, m_workQueue,
+                                             m_callback, m_timeMultiplier));
+    if (m_started) {
+      m_cooks.back()->start();
+    }
+  }
+
+  while (m_cooks.size() > cookCount) {
+    if (m_started) {
+      m_cooks.back()->retire();
+      m_retiredCooks.push_back(std::move(m_cooks.back()));
+    }
+    m_cooks.pop_back();
+  }
+}
+
+uint32_t ThreadCookPool::busyCooks() const {
+  uint32_t busyCooks = 0;
+  for (const auto &cook : m_cooks) {
+    if (cook->isBusy()) {
+      busyCooks++;
+    }
+  }
+  for (const auto &cook : m_retiredCooks) {
+    if (cook->isBusy()) {
+      busyCooks++;
+    }
+  }
+  return busyCooks;
+}
+} // namespace Plazza::Kitchen
@@ -0,0 +1,50 @@
+/**
+ * @file ThreadCookPool.hpp
+ * @brief Defines the ThreadCookPool class running one thread per cook.
+ */
+
+#pragma once
+
+#include "Core/ThreadQueue.hpp"
+#include "Kitchen/Cook.hpp"
+#include "Kitchen/CookPool.hpp"
+#include <memory>
+#include <vector>
+
+namespace Plazza::Kitchen {
+/**
+ * @class ThreadCookPool
+ * @brief Cooks running on their own threads, sharing one work queue.
+ */
+class ThreadCookPool : public CookPool {
+public:
+  /**
+   * @brief Constructs a ThreadCookPool instance.
+   * @param cookCount Number of cooks.
+   * @param callback Callback function to call when a task is completed.
+   * @param timeMultiplier Multiplier for cooking time to simulate different
+   * cooking speeds.
+   */
+  ThreadCookPool(uint32_t cookCount, Callback callback, double timeMultiplier);
+
+  /**
+   * @brief Destructor that stops the cooks.
+   */
+  ~ThreadCookPool() override;
+
+  void start() override;
+  void stop() override;
+  void submit(const CookingTask &task) override;
+  void resize(uint32_t cookCount) override;
+  [[nodiscard]] uint32_t busyCooks() const override;
+
+private:
+  Callback m_callback;
+  double m_timeMultiplier;
+  uint32_t m_nextCookId = 1;
+  bool m_started = false;
+  Core::ThreadQueue<CookingTask> m_workQueue;
+  std::vector<std::unique_ptr<Cook>> m_cooks;
+  std::vector<std::unique_ptr<Cook>> m_retiredCooks;
+};
+} // namespace Plazza::Kitchen
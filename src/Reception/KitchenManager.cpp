@@ -1,6 +1,7 @@
 #include "Reception/KitchenManager.hpp"
 #include "Communication/Serialization.hpp"
 #include "Core/Pizza.hpp"
+#include "Exceptions/ArgumentException.hpp"
 #include "Kitchen/Kitchen.hpp"
 #include "Logger/Logger.hpp"
 #include <algorithm>
@@ -8,13 +9,58 @@
 #include <iostream>
 
 namespace Plazza::Reception {
-KitchenManager::KitchenManager(uint32_t cooksPerKitchen,
-                               std::chrono::milliseconds stockRestockTime,
-                               double timeMultiplier)
-    : m_cooksPerKitchen(cooksPerKitchen), m_stockRestockTime(stockRestockTime),
-      m_timeMultiplier(timeMultiplier) {
+KitchenManager::KitchenManager(const Settings &settings)
+    : m_settings(settings) {
+  m_profiles.push_back({"default", m_settings.cooksPerKitchen,
+                        m_settings.stockRestockTime,
+                        Kitchen::Stock::INITIAL_STOCK});
+  m_profiles.insert(m_profiles.end(), m_settings.profiles.begin(),
+                    m_settings.profiles.end());
+
+  if (m_settings.kitchenHosting == KitchenHosting::Processes) {
+    m_zygote = std::make_unique<Core::Zygote>();
+    m_zygote->start([settings = m_settings](const std::string &request) {
+      Core::OpaqueObject object = Core::OpaqueObject::fromString(request);
+      uint32_t kitchenId = 0;
+      uint32_t cooksPerKitchen = 0;
+      int64_t restockTime = 0;
+      uint32_t initialStock = 0;
+      object.unpack(kitchenId)
+          .unpack(cooksPerKitchen)
+          .unpack(restockTime)
+          .unpack(initialStock);
+
+      Kitchen::Kitchen kitchen(
+          kitchenId, cooksPerKitchen, std::chrono::milliseconds(restockTime),
+          settings.timeMultiplier,
+          settings.dispatchMode == DispatchMode::SharedTable,
+          settings.cookModel, Communication::Transport::MessageQueue,
+          initialStock);
+      kitchen.run();
+    });
+  }
+
+  uint32_t largestProfile = 0;
+  for (const auto &profile : m_profiles) {
+    largestProfile = std::max(largestProfile, profile.cooks);
+  }
+
+  Communication::Transport transport =
+      m_settings.kitchenHosting == KitchenHosting::Threads
+          ? Communication::Transport::InMemory
+          : Communication::Transport::MessageQueue;
   m_ipcManager = std::make_unique<Communication::IPCManager>(
-      0, true, cooksPerKitchen * MAX_PIZZAS_PER_KITCHEN_MULTIPLIER);
+      0, true, largestProfile * MAX_PIZZAS_PER_KITCHEN_MULTIPLIER, transport);
+
+  if (m_settings.dispatchMode == DispatchMode::SharedTable) {
+    m_orderTable = std::make_unique<Communication::SharedOrderTable>(
+        Communication::SharedOrderTable::DEFAULT_NAME, true);
+  }
+
+  if (m_zygote) {
+    m_lifecycleLoop = std::make_unique<Core::EventLoop>();
+    m_lifecycleThread.start([this]() { m_lifecycleLoop->run(); });
+  }
 
   setupMessageHandlers();
   m_ipcManager->startListening();
@@ -34,56 +80,186 @@ void KitchenManager::setupMessageHandlers() {
   m_ipcManager->setMessageHandler(
       Communication::Message::MessageType::HEARTBEAT,
       [this](const Communication::Message &msg) { handleHeartbeat(msg); });
+
+  m_ipcManager->setMessageHandler(
+      Communication::Message::MessageType::ORDER_HANDBACK,
+      [this](const Communication::Message &msg) { handleOrderHandback(msg); });
+
+  m_ipcManager->setMessageHandler(
+      Communication::Message::MessageType::WORK_REQUEST,
+      [this](const Communication::Message &msg) { handleWorkRequest(msg); });
+
+  m_ipcManager->setMessageHandler(
+      Communication::Message::MessageType::DRAINED,
+      [this](const Communication::Message &msg) {
+        handleKitchenDrained(msg);
+      });
 }
 
-void KitchenManager::distributeOrder(
-    const std::vector<Communication::PizzaOrder> &orders) {
+DispatchReport
+KitchenManager::distributeOrder(const std::vector<OrderRun> &runs) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  DispatchReport report;
+
+  removeInactiveKitchens();
+  drainOverflow();
+
+  m_unroutedOrders = 0;
+  for (const auto &run : runs) {
+    m_unroutedOrders += run.count;
+  }
+
+  for (OrderRun run : runs) {
+    while (!run.empty()) {
+      Communication::PizzaOrder order = run.front();
+
+      if (m_orderTable && m_orderTable->publish(order)) {
+        trackOrder(order, 0);
+        LOG_INFO("Published pizza " + Core::toString(order.type) + " " +
+                 Core::toString(order.size) + " to the order table");
+      } else if (!m_overflowOrders.empty() || !dispatchOrder(order)) {
+        break;
+      }
+      ++report.dispatched;
+      --m_unroutedOrders;
+      run.popFront();
+    }
+
+    if (run.empty()) {
+      continue;
+    }
+    m_unroutedOrders -= run.count;
+    if (m_overflowOrders.size() >= m_settings.maxQueuedRuns) {
+      report.rejected += run.count;
+      continue;
+    }
+    report.deferred += run.count;
+    m_overflowOrders.push_back(run);
+    m_queuedOrders += run.count;
+  }
+
+  m_unroutedOrders = 0;
+
+  if (m_orderTable) {
+    ensureSharedCapacity();
+  }
   removeInactiveKitchens();
+  return report;
+}
 
-  for (const auto &order : orders) {
-    uint32_t kitchenId = findBestKitchen();
+bool KitchenManager::dispatchOrder(const Communication::PizzaOrder &order,
+                                   uint32_t excludedKitchen) {
+  uint32_t kitchenId = findBestKitchen(excludedKitchen);
 
+  if (kitchenId == 0) {
+    if (m_draining || m_kitchens.size() >= m_settings.maxKitchens) {
+      return false;
+    }
+    kitchenId = createKitchen(pickProfile(
+        std::max<size_t>(m_unroutedOrders, 1) + m_queuedOrders));
     if (kitchenId == 0) {
-      createKitchen();
-      kitchenId = m_nextKitchenId - 1;
+      return false;
     }
+  }
 
-    Core::OpaqueObject object = order.pack();
+  Communication::Message message = Communication::Message::create(
+      Communication::Message::MessageType::PIZZA_ORDER, 0,
+      order.pack().toString());
 
-    Communication::Message message{
-        Communication::Message::MessageType::PIZZA_ORDER, 0,
-        static_cast<uint32_t>(
-            std::chrono::duration_cast<std::chrono::seconds>(
-                std::chrono::system_clock::now().time_since_epoch())
-                .count()),
-        object.toString()};
+  KitchenInfo &kitchen = *m_kitchens.at(kitchenId);
+  if (!postToKitchen(kitchen, message)) {
+    return false;
+  }
 
-    try {
-      m_ipcManager->sendToKitchen(kitchenId, message);
+  kitchen.status.pendingPizzas++;
+  kitchen.lastHeartbeat = std::chrono::steady_clock::now();
+  trackOrder(order, kitchenId);
 
-      auto it = m_kitchens.find(kitchenId);
-      if (it != m_kitchens.end()) {
-        it->second->status.pendingPizzas++;
-        it->second->lastHeartbeat = std::chrono::steady_clock::now();
-      }
+  LOG_INFO("Assigned pizza " + Core::toString(order.type) + " " +
+           Core::toString(order.size) + " to kitchen " +
+           std::to_string(kitchenId));
+  return true;
+}
 
-      LOG_INFO("Assigned pizza " + Core::toString(order.type) + " " +
-               Core::toString(order.size) + " to kitchen " +
-               std::to_string(kitchenId));
-    } catch (const std::exception &e) {
-      LOG_ERROR("Failed to send order to kitchen " + std::to_string(kitchenId) +
-                ": " + e.what());
+bool KitchenManager::postToKitchen(KitchenInfo &kitchen,
+                                   const Communication::Message &message) {
+  if (!kitchen.outbox || !kitchen.outbox->post(message)) {
+    LOG_ERROR("Failed to send message to kitchen " +
+              std::to_string(kitchen.id) + ": outbox is full or closed");
+    return false;
+  }
+  return true;
+}
+
+void KitchenManager::drainOverflow() {
+  if (m_draining) {
+    return;
+  }
+
+  uint32_t drained = 0;
+
+  while (!m_overflowOrders.empty() &&
+         dispatchOrder(m_overflowOrders.front().front())) {
+    m_overflowOrders.front().popFront();
+    if (m_overflowOrders.front().empty()) {
+      m_overflowOrders.pop_front();
     }
+    --m_queuedOrders;
+    ++drained;
   }
-  removeInactiveKitchens();
+
+  if (drained > 0) {
+    LOG_INFO("Dispatched " + std::to_string(drained) + " queued orders, " +
+             std::to_string(m_queuedOrders) + " still waiting");
+  }
+}
+
+void KitchenManager::resizeCooks(uint32_t cooksPerKitchen,
+                                 const std::string &profile) {
+  if (cooksPerKitchen == 0) {
+    throw Exceptions::ArgumentException("Number of cooks must be positive");
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::vector<bool> resized(m_profiles.size(), false);
+  bool matched = false;
+  for (size_t i = 0; i < m_profiles.size(); ++i) {
+    if (profile.empty() || m_profiles[i].name == profile) {
+      m_profiles[i].cooks = cooksPerKitchen;
+      resized[i] = true;
+      matched = true;
+    }
+  }
+  if (!matched) {
+    throw Exceptions::ArgumentException("Unknown kitchen profile: " + profile);
+  }
+
+  Core::OpaqueObject object;
+  object.pack(cooksPerKitchen);
+  Communication::Message message = Communication::Message::create(
+      Communication::Message::MessageType::RESIZE_COOKS, 0, object.toString());
+
+  for (auto &[id, kitchen] : m_kitchens) {
+    if (!resized[kitchen->profile]) {
+      continue;
+    }
+    if (postToKitchen(*kitchen, message)) {
+      kitchen->status.totalCooks = cooksPerKitchen;
+    }
+  }
+  LOG_INFO((profile.empty() ? std::string("Kitchens")
+                            : "Kitchens of profile " + profile) +
+           " now have " + std::to_string(cooksPerKitchen) + " cooks");
+  drainOverflow();
 }
 
 void KitchenManager::displayStatus() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
   std::cout << "\n=== Kitchen Status ===" << std::endl;
   std::cout << std::left << std::setw(10) << "Kitchen" << std::setw(12)
-            << "Busy/Total" << std::setw(10) << "Pending" << std::setw(8)
-            << "Status" << std::endl;
-  std::cout << std::string(50, '-') << std::endl;
+            << "Profile" << std::setw(12) << "Busy/Total" << std::setw(10)
+            << "Pending" << std::setw(8) << "Status" << std::endl;
+  std::cout << std::string(62, '-') << std::endl;
 
   for (const auto &[id, kitchen] : m_kitchens) {
     auto now = std::chrono::steady_clock::now();
@@ -91,6 +267,7 @@ void KitchenManager::displayStatus() const {
     bool isActive = timeSinceHeartbeat < HEARTBEAT_TIMEOUT;
 
     std::cout << std::left << std::setw(10) << id << std::setw(12)
+              << m_profiles[kitchen->profile].name << std::setw(12)
               << (std::to_string(kitchen->status.busyCooks) + "/" +
                   std::to_string(kitchen->status.totalCooks))
               << std::setw(10) << kitchen->status.pendingPizzas << std::setw(8)
@@ -115,48 +292,138 @@ void KitchenManager::displayStatus() const {
     std::cout << "No kitchens running" << std::endl;
   }
 
+  if (m_queuedOrders > 0) {
+    std::cout << "Queued orders: " << m_queuedOrders << " in "
+              << m_overflowOrders.size() << "/" << m_settings.maxQueuedRuns
+              << " runs" << std::endl;
+  }
+
+  std::cout << "Orders: " << m_goodput.completed << " completed, "
+            << m_outstandingOrders.size() << " in flight, "
+            << m_goodput.recovered << " recovered, " << m_goodput.duplicates
+            << " duplicates dropped" << std::endl;
+
+  uint32_t deadlineOrders = m_lateness.onTime + m_lateness.late;
+  if (deadlineOrders > 0) {
+    std::cout << "Deadlines: " << m_lateness.onTime << "/" << deadlineOrders
+              << " on time";
+    if (m_lateness.late > 0) {
+      std::cout << ", mean lateness "
+                << m_lateness.totalLateness.count() / m_lateness.late
+                << "ms, max lateness " << m_lateness.maxLateness.count()
+                << "ms";
+    }
+    std::cout << std::endl;
+  }
+
   std::cout << "======================" << std::endl;
 
   const_cast<KitchenManager *>(this)->requestStatusUpdates();
 }
 
-void KitchenManager::cleanup() {
-  Communication::Message shutdownMessage{
-      Communication::Message::MessageType::SHUTDOWN, 0,
-      static_cast<uint32_t>(
-          std::chrono::duration_cast<std::chrono::seconds>(
-              std::chrono::system_clock::now().time_since_epoch())
-              .count()),
-      ""};
+void KitchenManager::waitUntilIdle() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_overflowOrders.empty() || !m_outstandingOrders.empty()) {
+    m_idleCondition.wait_for(lock, DRAIN_POLL_INTERVAL);
+    removeInactiveKitchens();
+    drainOverflow();
+    if (m_kitchens.empty() && !m_overflowOrders.empty()) {
+      LOG_ERROR("No kitchen can take the " + std::to_string(m_queuedOrders) +
+                " queued orders");
+      return;
+    }
+  }
+}
 
-  for (const auto &[id, kitchen] : m_kitchens) {
-    try {
-      m_ipcManager->sendToKitchen(id, shutdownMessage);
-    } catch (const std::exception &e) {
-      LOG_ERROR("Failed to send shutdown to kitchen " + std::to_string(id) +
-                ": " + e.what());
+DrainReport KitchenManager::drain() {
+  DrainReport report;
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + m_settings.drainTimeout;
+  uint32_t completedBefore = 0;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_draining = true;
+    completedBefore = m_goodput.completed;
+
+    Communication::Message drainMessage = Communication::Message::create(
+        Communication::Message::MessageType::DRAIN, 0);
+    for (auto &[id, kitchen] : m_kitchens) {
+      postToKitchen(*kitchen, drainMessage);
+    }
+
+    auto isDrained = [this]() {
+      return std::none_of(m_kitchens.begin(), m_kitchens.end(),
+                          [](const auto &entry) {
+                            return entry.second->active;
+                          });
+    };
+    auto now = std::chrono::steady_clock::now();
+    while (!isDrained() && now < deadline) {
+      auto wakeup = std::min<std::chrono::steady_clock::time_point>(
+          deadline, now + DRAIN_POLL_INTERVAL);
+      m_drainCondition.wait_until(lock, wakeup);
+      removeInactiveKitchens();
+      now = std::chrono::steady_clock::now();
     }
   }
 
-  for (auto &[id, kitchen] : m_kitchens) {
+  cleanup();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    report.completed = m_goodput.completed - completedBefore;
+    report.abandoned = m_outstandingOrders.size();
+    report.queued = m_queuedOrders;
+  }
+  report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  return report;
+}
+
+void KitchenManager::cleanup() {
+  Communication::Message shutdownMessage = Communication::Message::create(
+      Communication::Message::MessageType::SHUTDOWN, 0);
+
+  std::unordered_map<uint32_t, std::unique_ptr<KitchenInfo>> kitchens;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &[id, kitchen] : m_kitchens) {
+      if (!postToKitchen(*kitchen, shutdownMessage) && kitchen->process) {
+        kitchen->process->terminate();
+      }
+    }
+    kitchens.swap(m_kitchens);
+  }
+
+  for (auto &[id, kitchen] : kitchens) {
+    if (kitchen->outbox) {
+      kitchen->outbox->close(true);
+    }
     if (kitchen->process) {
       kitchen->process->wait();
     }
+    if (kitchen->thread) {
+      kitchen->thread->join();
+    }
   }
 
-  m_kitchens.clear();
+  if (m_lifecycleLoop) {
+    m_lifecycleLoop->stop();
+    m_lifecycleThread.join();
+  }
 
   if (m_ipcManager) {
     m_ipcManager->stopListening();
+    m_ipcManager->processPending();
   }
 }
 
-uint32_t KitchenManager::findBestKitchen() const {
+uint32_t KitchenManager::findBestKitchen(uint32_t excludedKitchen) const {
   uint32_t bestKitchen = 0;
-  uint32_t minimumLoadThreshold = UINT32_MAX;
+  uint64_t bestLoad = 0;
+  uint64_t bestCooks = 0;
 
   for (const auto &[id, kitchen] : m_kitchens) {
-    if (!kitchen->active)
+    if (!kitchen->active || id == excludedKitchen)
       continue;
 
     auto now = std::chrono::steady_clock::now();
@@ -164,47 +431,183 @@ uint32_t KitchenManager::findBestKitchen() const {
       continue;
     }
 
-    uint32_t maxCapacity =
-        kitchen->status.totalCooks * MAX_PIZZAS_PER_KITCHEN_MULTIPLIER;
+    uint32_t cooks = std::max(kitchen->status.totalCooks, 1u);
+    uint32_t maxCapacity = cooks * MAX_PIZZAS_PER_KITCHEN_MULTIPLIER;
     uint32_t currentLoad = kitchen->status.pendingPizzas;
+    if (currentLoad >= maxCapacity) {
+      continue;
+    }
 
-    if (currentLoad < maxCapacity && currentLoad < minimumLoadThreshold) {
-      minimumLoadThreshold = currentLoad;
+    uint64_t load = static_cast<uint64_t>(currentLoad) * bestCooks;
+    uint64_t best = bestLoad * cooks;
+    if (bestKitchen == 0 || load < best ||
+        (load == best && cooks > bestCooks)) {
       bestKitchen = id;
+      bestLoad = currentLoad;
+      bestCooks = cooks;
     }
   }
 
   return bestKitchen;
 }
 
-void KitchenManager::createKitchen() {
+uint32_t KitchenManager::capacityOf(size_t profile) const {
+  return m_profiles[profile].cooks * MAX_PIZZAS_PER_KITCHEN_MULTIPLIER;
+}
+
+size_t KitchenManager::pickProfile(size_t demand) const {
+  size_t smallestFit = m_profiles.size();
+  size_t largest = 0;
+
+  for (size_t i = 0; i < m_profiles.size(); ++i) {
+    uint32_t capacity = capacityOf(i);
+    if (capacity >= demand &&
+        (smallestFit == m_profiles.size() ||
+         m_profiles[i].cooks < m_profiles[smallestFit].cooks)) {
+      smallestFit = i;
+    }
+    if (capacity > capacityOf(largest) ||
+        (capacity == capacityOf(largest) &&
+         m_profiles[i].cooks > m_profiles[largest].cooks)) {
+      largest = i;
+    }
+  }
+
+  return smallestFit < m_profiles.size() ? smallestFit : largest;
+}
+
+uint32_t KitchenManager::createKitchen(size_t profile) {
   uint32_t kitchenId = m_nextKitchenId++;
 
   auto kitchenInfo = std::make_unique<KitchenInfo>();
   kitchenInfo->id = kitchenId;
-  kitchenInfo->process = std::make_unique<Core::Process>();
   kitchenInfo->lastHeartbeat = std::chrono::steady_clock::now();
   kitchenInfo->status.kitchenId = kitchenId;
-  kitchenInfo->status.totalCooks = m_cooksPerKitchen;
+  kitchenInfo->status.totalCooks = m_profiles[profile].cooks;
+  kitchenInfo->profile = profile;
   kitchenInfo->status.busyCooks = 0;
   kitchenInfo->status.pendingPizzas = 0;
 
-  m_ipcManager->createKitchenChannel(kitchenId);
-
   try {
-    kitchenInfo->process->fork([this, kitchenId]() {
-      Kitchen::Kitchen kitchen(kitchenId, m_cooksPerKitchen, m_stockRestockTime,
-                               m_timeMultiplier);
-      kitchen.run();
-    });
+    m_ipcManager->createKitchenChannel(kitchenId, capacityOf(profile));
+
+    startKitchen(*kitchenInfo);
+    kitchenInfo->outbox = std::make_unique<KitchenOutbox>(
+        *m_ipcManager, kitchenId, capacityOf(profile) + OUTBOX_SLACK);
 
     m_kitchens[kitchenId] = std::move(kitchenInfo);
-    LOG_INFO("Created kitchen " + std::to_string(kitchenId));
+    LOG_INFO("Created kitchen " + std::to_string(kitchenId) + " (" +
+             m_profiles[profile].name + ")");
+    return kitchenId;
 
   } catch (const std::exception &e) {
     LOG_ERROR("Failed to create kitchen " + std::to_string(kitchenId) + ": " +
               e.what());
     m_ipcManager->removeKitchenChannel(kitchenId);
+    return 0;
+  }
+}
+
+void KitchenManager::startKitchen(KitchenInfo &kitchenInfo) {
+  const KitchenProfile &profile = m_profiles[kitchenInfo.profile];
+  if (m_settings.kitchenHosting == KitchenHosting::Processes) {
+    Core::OpaqueObject request;
+    request.pack(kitchenInfo.id)
+        .pack(profile.cooks)
+        .pack(static_cast<int64_t>(profile.restockTime.count()))
+        .pack(profile.initialStock);
+    kitchenInfo.process =
+        std::make_unique<Core::Process>(m_zygote->spawn(request.toString()));
+    watchKitchen(kitchenInfo);
+    return;
+  }
+
+  auto running = std::make_shared<std::atomic<bool>>(true);
+  kitchenInfo.threadRunning = running;
+  kitchenInfo.thread = std::make_unique<Core::Thread>();
+  kitchenInfo.thread->start(
+      [settings = m_settings, profile, kitchenId = kitchenInfo.id, running]() {
+        try {
+          Kitchen::Kitchen kitchen(
+              kitchenId, profile.cooks, profile.restockTime,
+              settings.timeMultiplier,
+              settings.dispatchMode == DispatchMode::SharedTable,
+              settings.cookModel, Communication::Transport::InMemory,
+              profile.initialStock);
+          kitchen.run();
+        } catch (const std::exception &e) {
+          LOG_ERROR("Kitchen " + std::to_string(kitchenId) +
+                    " stopped: " + e.what());
+        }
+        *running = false;
+      });
+}
+
+bool KitchenManager::isRunning(const KitchenInfo &kitchen) {
+  if (kitchen.thread) {
+    return kitchen.threadRunning->load();
+  }
+  if (!kitchen.process) {
+    return false;
+  }
+  if (kitchen.process->getDescriptor() != -1) {
+    return !kitchen.exited;
+  }
+  return kitchen.process->isRunning();
+}
+
+void KitchenManager::watchKitchen(const KitchenInfo &kitchen) {
+  int pidfd = kitchen.process->getDescriptor();
+  if (pidfd == -1) {
+    return;
+  }
+
+  m_lifecycleLoop->post([this, kitchenId = kitchen.id, pidfd]() {
+    try {
+      m_lifecycleLoop->watch(pidfd, [this, kitchenId, pidfd]() {
+        m_lifecycleLoop->unwatch(pidfd);
+        handleKitchenExit(kitchenId);
+      });
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to watch kitchen " + std::to_string(kitchenId) +
+                ": " + e.what());
+    }
+  });
+}
+
+void KitchenManager::handleKitchenExit(uint32_t kitchenId) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_kitchens.find(kitchenId);
+  if (it == m_kitchens.end()) {
+    return;
+  }
+
+  LOG_INFO("Kitchen " + std::to_string(kitchenId) + " exited");
+  it->second->exited = true;
+  removeInactiveKitchens();
+}
+
+void KitchenManager::retireProcess(std::unique_ptr<Core::Process> process) {
+  std::shared_ptr<Core::Process> retired = std::move(process);
+  m_lifecycleLoop->post([this, retired]() {
+    m_lifecycleLoop->unwatch(retired->getDescriptor());
+    retired->terminate();
+  });
+}
+
+void KitchenManager::ensureSharedCapacity() {
+  size_t capacity = 0;
+  for (const auto &[id, kitchen] : m_kitchens) {
+    capacity += capacityOf(kitchen->profile);
+  }
+
+  size_t occupied = m_orderTable->occupied();
+  while (occupied > capacity && m_kitchens.size() < m_settings.maxKitchens) {
+    size_t profile = pickProfile(occupied - capacity);
+    if (createKitchen(profile) == 0) {
+      break;
+    }
+    capacity += capacityOf(profile);
   }
 }
 
@@ -213,36 +616,91 @@ void KitchenManager::removeInactiveKitchens() {
   std::vector<uint32_t> toRemove;
 
   for (const auto &[id, kitchen] : m_kitchens) {
-    if (!kitchen->process->isRunning() ||
+    if (!isRunning(*kitchen) ||
         (now - kitchen->lastHeartbeat > HEARTBEAT_TIMEOUT)) {
       toRemove.push_back(id);
     }
   }
 
+  if (!toRemove.empty()) {
+    m_drainCondition.notify_all();
+  }
+
   for (uint32_t id : toRemove) {
     LOG_INFO("Removing inactive kitchen " + std::to_string(id));
+    auto &kitchen = m_kitchens[id];
+    if (kitchen->outbox) {
+      kitchen->outbox->close(false);
+    }
     m_ipcManager->removeKitchenChannel(id);
+    if (kitchen->thread && isRunning(*kitchen)) {
+      kitchen->thread->detach();
+    }
+    if (kitchen->process && m_lifecycleLoop) {
+      retireProcess(std::move(kitchen->process));
+    }
     m_kitchens.erase(id);
+    if (!m_draining) {
+      recoverOrders(id);
+    }
+
+    if (m_orderTable) {
+      uint32_t reclaimed = m_orderTable->reclaim(id);
+      if (reclaimed > 0) {
+        LOG_INFO("Put back " + std::to_string(reclaimed) +
+                 " orders claimed by kitchen " + std::to_string(id));
+      }
+    }
   }
 }
 
-void KitchenManager::requestStatusUpdates() {
-  Communication::Message message{
-      Communication::Message::MessageType::STATUS_REQUEST, 0,
-      static_cast<uint32_t>(
-          std::chrono::duration_cast<std::chrono::seconds>(
-              std::chrono::system_clock::now().time_since_epoch())
-              .count()),
-      ""};
+void KitchenManager::trackOrder(const Communication::PizzaOrder &order,
+                                uint32_t kitchenId) {
+  auto [it, inserted] = m_outstandingOrders.try_emplace(order.orderId);
+  it->second.order = order;
+  it->second.kitchenId = kitchenId;
+  it->second.dispatchedAt = std::chrono::steady_clock::now();
+
+  if (kitchenId == 0) {
+    it->second.state = OrderState::Published;
+  } else {
+    it->second.state =
+        inserted ? OrderState::Dispatched : OrderState::Redispatched;
+  }
+}
 
-  for (const auto &[id, kitchen] : m_kitchens) {
-    try {
-      m_ipcManager->sendToKitchen(id, message);
-    } catch (const std::exception &e) {
-      LOG_ERROR("Failed to request status from kitchen " + std::to_string(id) +
-                ": " + e.what());
+void KitchenManager::recoverOrders(uint32_t kitchenId) {
+  std::vector<Communication::PizzaOrder> lostOrders;
+  for (const auto &[orderId, outstanding] : m_outstandingOrders) {
+    if (outstanding.kitchenId == kitchenId) {
+      lostOrders.push_back(outstanding.order);
     }
   }
+
+  if (lostOrders.empty()) {
+    return;
+  }
+
+  LOG_WARN("Kitchen " + std::to_string(kitchenId) + " was lost with " +
+           std::to_string(lostOrders.size()) + " orders, redispatching");
+
+  for (const auto &order : lostOrders) {
+    ++m_goodput.recovered;
+    if (!dispatchOrder(order, kitchenId)) {
+      m_outstandingOrders.erase(order.orderId);
+      m_overflowOrders.push_front(OrderRun::of(order));
+      ++m_queuedOrders;
+    }
+  }
+}
+
+void KitchenManager::requestStatusUpdates() {
+  Communication::Message message = Communication::Message::create(
+      Communication::Message::MessageType::STATUS_REQUEST, 0);
+
+  for (auto &[id, kitchen] : m_kitchens) {
+    postToKitchen(*kitchen, message);
+  }
 }
 
 void KitchenManager::handlePizzaCompleted(
@@ -259,18 +717,57 @@ void KitchenManager::handlePizzaCompleted(
              Core::toString(pizza.getSize()) + " from kitchen " +
              std::to_string(completion.pizza.getKitchenId()));
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t orderId = completion.pizza.getOrderId();
+    if (m_outstandingOrders.erase(orderId) > 0) {
+      ++m_goodput.completed;
+      if (completion.deadline != 0) {
+        recordLateness(completion);
+      }
+    } else {
+      ++m_goodput.duplicates;
+      LOG_WARN("Dropping duplicate completion of order " +
+               std::to_string(orderId) + " from kitchen " +
+               std::to_string(message.getSenderId()));
+    }
+
     auto it = m_kitchens.find(message.getSenderId());
     if (it != m_kitchens.end()) {
-      it->second->status.pendingPizzas =
-          std::max(0u, it->second->status.pendingPizzas - 1);
+      if (it->second->status.pendingPizzas > 0) {
+        it->second->status.pendingPizzas--;
+      }
       it->second->lastHeartbeat = std::chrono::steady_clock::now();
     }
+    drainOverflow();
+    if (m_overflowOrders.empty() && m_outstandingOrders.empty()) {
+      m_idleCondition.notify_all();
+    }
 
   } catch (const std::exception &e) {
     LOG_ERROR("Error handling pizza completion: " + std::string(e.what()));
   }
 }
 
+void KitchenManager::recordLateness(
+    const Communication::PizzaCompletion &completion) {
+  auto dueAt = std::chrono::steady_clock::time_point(
+      std::chrono::nanoseconds(completion.deadline));
+  auto lateness = std::chrono::duration_cast<std::chrono::milliseconds>(
+      completion.completionTime - dueAt);
+
+  if (lateness.count() <= 0) {
+    ++m_lateness.onTime;
+    return;
+  }
+
+  ++m_lateness.late;
+  m_lateness.totalLateness += lateness;
+  m_lateness.maxLateness = std::max(m_lateness.maxLateness, lateness);
+  LOG_WARN("Order " + std::to_string(completion.pizza.getOrderId()) +
+           " missed its deadline by " + std::to_string(lateness.count()) +
+           "ms");
+}
+
 void KitchenManager::handleStatusResponse(
     const Communication::Message &message) {
   try {
@@ -279,6 +776,7 @@ void KitchenManager::handleStatusResponse(
     Communication::KitchenStatus status;
     status.unpack(object);
 
+    std::lock_guard<std::mutex> lock(m_mutex);
     auto it = m_kitchens.find(message.getSenderId());
     if (it != m_kitchens.end()) {
       it->second->status = status;
@@ -290,10 +788,104 @@ void KitchenManager::handleStatusResponse(
   }
 }
 
+void KitchenManager::handleKitchenDrained(
+    const Communication::Message &message) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_kitchens.find(message.getSenderId());
+  if (it != m_kitchens.end()) {
+    it->second->active = false;
+    m_drainCondition.notify_all();
+  }
+}
+
 void KitchenManager::handleHeartbeat(const Communication::Message &message) {
+  std::lock_guard<std::mutex> lock(m_mutex);
   auto it = m_kitchens.find(message.getSenderId());
   if (it != m_kitchens.end()) {
     it->second->lastHeartbeat = std::chrono::steady_clock::now();
   }
+  removeInactiveKitchens();
+}
+
+void KitchenManager::handleOrderHandback(
+    const Communication::Message &message) {
+  try {
+    Core::OpaqueObject object =
+        Core::OpaqueObject::fromString(message.getPayload());
+    Communication::PizzaOrder order;
+    order.unpack(object);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_kitchens.find(message.getSenderId());
+    if (it != m_kitchens.end() && it->second->status.pendingPizzas > 0) {
+      it->second->status.pendingPizzas--;
+    }
+
+    auto outstanding = m_outstandingOrders.find(order.orderId);
+    if (outstanding == m_outstandingOrders.end() ||
+        outstanding->second.kitchenId != message.getSenderId()) {
+      LOG_WARN("Dropping stale handback of order " +
+               std::to_string(order.orderId) + " from kitchen " +
+               std::to_string(message.getSenderId()));
+      return;
+    }
+
+    LOG_INFO("Kitchen " + std::to_string(message.getSenderId()) +
+             " handed back pizza " + Core::toString(order.type) + " " +
+             Core::toString(order.size) + ", re-routing");
+    if (!dispatchOrder(order, message.getSenderId())) {
+      m_outstandingOrders.erase(order.orderId);
+      m_overflowOrders.push_front(OrderRun::of(order));
+      ++m_queuedOrders;
+    }
+
+  } catch (const std::exception &e) {
+    LOG_ERROR("Error handling order handback: " + std::string(e.what()));
+  }
+}
+
+void KitchenManager::handleWorkRequest(const Communication::Message &message) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto requester = m_kitchens.find(message.getSenderId());
+  if (requester == m_kitchens.end()) {
+    return;
+  }
+  requester->second->lastHeartbeat = std::chrono::steady_clock::now();
+
+  uint32_t donorKitchen = 0;
+  uint32_t largestBacklog = 0;
+
+  for (const auto &[id, kitchen] : m_kitchens) {
+    if (id == message.getSenderId())
+      continue;
+
+    uint32_t backlog =
+        kitchen->status.pendingPizzas > kitchen->status.totalCooks
+            ? kitchen->status.pendingPizzas - kitchen->status.totalCooks
+            : 0;
+    if (backlog > largestBacklog) {
+      largestBacklog = backlog;
+      donorKitchen = id;
+    }
+  }
+
+  if (donorKitchen == 0) {
+    return;
+  }
+
+  uint32_t count =
+      std::min(largestBacklog, requester->second->status.totalCooks);
+  Core::OpaqueObject object;
+  object.pack(count);
+
+  Communication::Message recall = Communication::Message::create(
+      Communication::Message::MessageType::RECALL_ORDERS, 0,
+      object.toString());
+
+  if (postToKitchen(*m_kitchens.at(donorKitchen), recall)) {
+    LOG_INFO("Recalling " + std::to_string(count) + " orders from kitchen " +
+             std::to_string(donorKitchen) + " for idle kitchen " +
+             std::to_string(message.getSenderId()));
+  }
 }
 } // namespace Plazza::Reception
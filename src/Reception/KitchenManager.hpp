@@ -7,23 +7,103 @@
 
 #include "Communication/IPCManager.hpp"
 #include "Communication/Serialization.hpp"
+#include "Communication/SharedOrderTable.hpp"
+#include "Core/EventLoop.hpp"
 #include "Core/Process.hpp"
+#include "Core/Thread.hpp"
+#include "Core/Zygote.hpp"
+#include "Reception/KitchenOutbox.hpp"
+#include "Reception/OrderRun.hpp"
+#include "Reception/Settings.hpp"
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 namespace Plazza::Reception {
 /**
  * @struct KitchenInfo
- * @brief Contains information about a kitchen process.
+ * @brief Contains information about a kitchen process or thread.
  */
 struct KitchenInfo {
   uint32_t id;
   std::unique_ptr<Core::Process> process;
+  std::unique_ptr<Core::Thread> thread; ///< Set for kitchens run as threads.
+  std::shared_ptr<std::atomic<bool>> threadRunning;
+  std::unique_ptr<KitchenOutbox> outbox; ///< Sends its messages in order.
   std::chrono::steady_clock::time_point lastHeartbeat;
   Communication::KitchenStatus status;
-  bool active = true;
+  size_t profile = 0; ///< Index of its profile among the kitchen profiles.
+  bool active = true; ///< Cleared once the kitchen reports it is drained.
+  bool exited = false; ///< Set when the pidfd of the process reports its exit.
+};
+
+/**
+ * @struct DispatchReport
+ * @brief Outcome of distributing a batch of orders.
+ */
+struct DispatchReport {
+  uint64_t dispatched = 0; ///< Orders sent to a kitchen or the order table.
+  uint64_t deferred = 0;   ///< Orders waiting in the reception queue.
+  uint64_t rejected = 0;   ///< Orders dropped because the queue is full.
+};
+
+/**
+ * @struct DrainReport
+ * @brief Outcome of draining the kitchens on shutdown.
+ */
+struct DrainReport {
+  uint32_t completed = 0; ///< Orders delivered while draining.
+  uint32_t abandoned = 0; ///< Orders still in kitchens at the deadline.
+  uint64_t queued = 0;    ///< Orders that never reached a kitchen.
+  std::chrono::milliseconds duration{0};
+};
+
+/**
+ * @enum OrderState
+ * @brief Enum representing where an outstanding order is.
+ */
+enum class OrderState {
+  Dispatched,   ///< Sent to a kitchen.
+  Redispatched, ///< Sent to another kitchen after a handback or a loss.
+  Published     ///< Waiting in, or claimed from, the shared order table.
+};
+
+/**
+ * @struct OutstandingOrder
+ * @brief An order sent out by the reception and not completed yet.
+ */
+struct OutstandingOrder {
+  Communication::PizzaOrder order;
+  uint32_t kitchenId = 0; ///< 0 while the order is in the shared table.
+  OrderState state = OrderState::Dispatched;
+  std::chrono::steady_clock::time_point dispatchedAt;
+};
+
+/**
+ * @struct GoodputStats
+ * @brief Counts of orders delivered, recovered from lost kitchens, and
+ * dropped as duplicates.
+ */
+struct GoodputStats {
+  uint32_t completed = 0;
+  uint32_t recovered = 0;
+  uint32_t duplicates = 0;
+};
+
+/**
+ * @struct LatenessStats
+ * @brief Delivery statistics of orders placed with a deadline.
+ */
+struct LatenessStats {
+  uint32_t onTime = 0;
+  uint32_t late = 0;
+  std::chrono::milliseconds totalLateness{0};
+  std::chrono::milliseconds maxLateness{0};
 };
 
 /**
@@ -34,14 +114,9 @@ class KitchenManager {
 public:
   /**
    * @brief Constructs a KitchenManager instance.
-   * @param cooksPerKitchen Number of cooks per kitchen.
-   * @param stockRestockTime Time interval for stock replenishment.
-   * @param timeMultiplier Multiplier for cooking time to simulate different
-   * cooking speeds.
+   * @param settings Runtime settings of the kitchens to create.
    */
-  KitchenManager(uint32_t cooksPerKitchen,
-                 std::chrono::milliseconds stockRestockTime,
-                 double timeMultiplier);
+  explicit KitchenManager(const Settings &settings);
 
   /**
    * @brief Destructor that stops the kitchen manager.
@@ -50,15 +125,46 @@ public:
 
   /**
    * @brief Distributes pizza orders to the best available kitchen.
-   * @param orders Vector of pizza orders to distribute.
+   * In shared table mode, orders are published in the order table instead and
+   * are only routed directly when the table is full. Runs are streamed one
+   * order at a time until no kitchen can take more; what remains of a run
+   * waits whole in a reception queue, and is rejected once the queue holds
+   * the maximum number of runs of the settings.
+   * @param runs The runs of pizza orders to distribute.
+   * @return How many orders were dispatched, deferred and rejected.
+   */
+  DispatchReport distributeOrder(const std::vector<OrderRun> &runs);
+
+  /**
+   * @brief Changes the number of cooks of the running kitchens of a profile
+   * and of the kitchens of that profile created afterwards.
+   * @param cooksPerKitchen The new number of cooks per kitchen.
+   * @param profile The name of the profile, or empty for every profile.
+   * @throws Exceptions::ArgumentException if the number is zero or the
+   * profile is unknown.
    */
-  void distributeOrder(const std::vector<Communication::PizzaOrder> &orders);
+  void resizeCooks(uint32_t cooksPerKitchen, const std::string &profile = "");
 
   /**
    * @brief Displays the status of all kitchens.
    */
   void displayStatus() const;
 
+  /**
+   * @brief Waits until every queued order is dispatched and every dispatched
+   * order is completed, for input that ended with orders still waiting.
+   * Returns early if no kitchen can be started to take the queued orders.
+   */
+  void waitUntilIdle();
+
+  /**
+   * @brief Stops taking orders and lets every kitchen finish the orders it
+   * holds, in parallel, until all are drained or the drain timeout of the
+   * settings expires. Kitchens still running then are shut down.
+   * @return How many orders were completed and abandoned.
+   */
+  DrainReport drain();
+
   /**
    * @brief Cleans up resources and stops all kitchen processes.
    */
@@ -76,6 +182,26 @@ private:
    */
   void handlePizzaCompleted(const Communication::Message &message);
 
+  /**
+   * @brief Records an order in the outstanding orders index.
+   * @param order The order sent out.
+   * @param kitchenId The kitchen it was sent to, or 0 for the shared table.
+   */
+  void trackOrder(const Communication::PizzaOrder &order, uint32_t kitchenId);
+
+  /**
+   * @brief Redispatches the uncompleted orders of a lost kitchen.
+   * Late completions from the lost kitchen are dropped as duplicates.
+   * @param kitchenId The ID of the lost kitchen.
+   */
+  void recoverOrders(uint32_t kitchenId);
+
+  /**
+   * @brief Records how late a completed order was against its deadline.
+   * @param completion The completion of an order placed with a deadline.
+   */
+  void recordLateness(const Communication::PizzaCompletion &completion);
+
   /**
    * @brief Handles status response messages from kitchens.
    * @param message The received message containing kitchen status.
@@ -88,16 +214,130 @@ private:
    */
   void handleHeartbeat(const Communication::Message &message);
 
+  /**
+   * @brief Handles orders handed back by a kitchen and re-routes them.
+   * @param message The received message containing the returned order.
+   */
+  void handleOrderHandback(const Communication::Message &message);
+
+  /**
+   * @brief Handles work requests from idle kitchens.
+   * Recalls queued orders from the most backlogged kitchen so they can be
+   * re-routed.
+   * @param message The received message identifying the idle kitchen.
+   */
+  void handleWorkRequest(const Communication::Message &message);
+
+  /**
+   * @brief Handles a kitchen reporting it finished draining.
+   * Every completion it sent was handled before, as they share the inbox.
+   * @param message The received message identifying the kitchen.
+   */
+  void handleKitchenDrained(const Communication::Message &message);
+
+  /**
+   * @brief Sends a single order to the best available kitchen.
+   * Creates a new kitchen if none can take the order and the kitchen limit
+   * is not reached.
+   * @param order The order to dispatch.
+   * @param excludedKitchen ID of a kitchen that must not receive the order, or
+   * 0 for none.
+   * @return True if the order was sent, false otherwise.
+   */
+  bool dispatchOrder(const Communication::PizzaOrder &order,
+                     uint32_t excludedKitchen = 0);
+
+  /**
+   * @brief Queues a message in the outbox of a kitchen.
+   * The message is sent by the outbox thread, after the messages queued
+   * before it, so the caller never waits on the inbox of the kitchen. Posting
+   * does not block either, as it runs under the manager lock: a full outbox
+   * fails the post, and orders that cannot be posted stay queued.
+   * @param kitchen The kitchen to send to.
+   * @param message The message to send.
+   * @return True if the message was queued, false otherwise.
+   */
+  bool postToKitchen(KitchenInfo &kitchen,
+                     const Communication::Message &message);
+
+  /**
+   * @brief Dispatches queued orders in arrival order while kitchens can take
+   * them, splitting queued runs as needed.
+   */
+  void drainOverflow();
+
   /**
    * @brief Finds the best kitchen to handle a new order.
+   * Kitchens are compared by pending pizzas per cook, so a large kitchen takes
+   * proportionally more orders than a small one, and ties go to the larger
+   * kitchen.
+   * @param excludedKitchen ID of a kitchen to skip, or 0 for none.
    * @return The ID of the best kitchen, or 0 if no suitable kitchen is found.
    */
-  uint32_t findBestKitchen() const;
+  uint32_t findBestKitchen(uint32_t excludedKitchen = 0) const;
+
+  /**
+   * @brief Gets how many pizzas a kitchen of a profile can hold.
+   * @param profile Index of the profile.
+   * @return The capacity. The inbox of the kitchen may be shallower, as the
+   * kitchen empties it into its pending orders and the outbox retries.
+   */
+  uint32_t capacityOf(size_t profile) const;
+
+  /**
+   * @brief Picks the profile of the next kitchen to create.
+   * @param demand How many orders wait for a kitchen.
+   * @return Index of the smallest profile that can hold the demand, or of the
+   * largest profile if none can.
+   */
+  size_t pickProfile(size_t demand) const;
 
   /**
    * @brief Creates a new kitchen process.
+   * @param profile Index of the profile of the kitchen.
+   * @return The ID of the new kitchen, or 0 if it could not be created.
+   */
+  uint32_t createKitchen(size_t profile);
+
+  /**
+   * @brief Creates kitchens until they can hold every order of the shared
+   * table.
+   */
+  void ensureSharedCapacity();
+
+  /**
+   * @brief Starts the kitchen described by a kitchen info, as a process forked
+   * by the zygote or as a thread, depending on the settings.
+   * @param kitchenInfo The kitchen to start.
+   */
+  void startKitchen(KitchenInfo &kitchenInfo);
+
+  /**
+   * @brief Checks if the process or thread of a kitchen is still running.
+   * @param kitchen The kitchen to check.
+   * @return True if the kitchen is running, false otherwise.
+   */
+  static bool isRunning(const KitchenInfo &kitchen);
+
+  /**
+   * @brief Watches the pidfd of a kitchen process from the lifecycle loop.
+   * @param kitchen The kitchen to watch.
+   */
+  void watchKitchen(const KitchenInfo &kitchen);
+
+  /**
+   * @brief Handles the exit of a kitchen process, reported by its pidfd.
+   * Runs on the lifecycle loop.
+   * @param kitchenId The ID of the kitchen that exited.
+   */
+  void handleKitchenExit(uint32_t kitchenId);
+
+  /**
+   * @brief Terminates and reaps a removed kitchen process on the lifecycle
+   * loop, so the order path does not wait for it.
+   * @param process The process of the removed kitchen.
    */
-  void createKitchen();
+  void retireProcess(std::unique_ptr<Core::Process> process);
 
   /**
    * @brief Removes kitchens that have not sent a heartbeat within the timeout.
@@ -112,12 +352,29 @@ private:
 private:
   static constexpr uint32_t MAX_PIZZAS_PER_KITCHEN_MULTIPLIER = 2;
   static constexpr std::chrono::seconds HEARTBEAT_TIMEOUT{10};
+  static constexpr std::chrono::milliseconds DRAIN_POLL_INTERVAL{50};
+  static constexpr size_t OUTBOX_SLACK = 16; ///< Room for control messages.
 
+  mutable std::mutex m_mutex;
+  std::condition_variable m_drainCondition;
+  std::condition_variable m_idleCondition;
+  bool m_draining = false;
   std::unordered_map<uint32_t, std::unique_ptr<KitchenInfo>> m_kitchens;
+  std::unique_ptr<Core::Zygote> m_zygote;
+  std::unique_ptr<Core::EventLoop> m_lifecycleLoop;
+  Core::Thread m_lifecycleThread;
   std::unique_ptr<Communication::IPCManager> m_ipcManager;
+  std::unique_ptr<Communication::SharedOrderTable> m_orderTable;
+  std::deque<OrderRun> m_overflowOrders;
+  uint64_t m_queuedOrders = 0; ///< Orders in all the runs of the queue.
+  /// The default profile, then those of the settings, in their order.
+  /// Kitchens refer to them by index, so they are never reordered.
+  std::vector<KitchenProfile> m_profiles;
+  size_t m_unroutedOrders = 0; ///< Orders of the batch not routed yet.
+  std::unordered_map<uint64_t, OutstandingOrder> m_outstandingOrders;
+  GoodputStats m_goodput;
+  LatenessStats m_lateness;
   uint32_t m_nextKitchenId = 1;
-  uint32_t m_cooksPerKitchen;
-  std::chrono::milliseconds m_stockRestockTime;
-  double m_timeMultiplier;
+  Settings m_settings;
 };
 } // namespace Plazza::Reception
@@ -0,0 +1,59 @@
+/**
+ * @file KitchenOutbox.cpp
+ * @brief Implements the KitchenOutbox class.
+ */
+
+#include "Reception/KitchenOutbox.hpp"
+#include "Logger/Logger.hpp"
+
+namespace Plazza::Reception {
+KitchenOutbox::KitchenOutbox(Communication::IPCManager &ipcManager,
+                             uint32_t kitchenId, size_t capacity)
+    : m_ipcManager(ipcManager), m_kitchenId(kitchenId), m_queue(capacity) {
+  m_thread.start([this]() { run(); });
+}
+
+KitchenOutbox::~KitchenOutbox() { close(false); }
+
+bool KitchenOutbox::post(const Communication::Message &message) {
+  return m_queue.tryPush(message);
+}
+
+void KitchenOutbox::close(bool flush) {
+  if (!flush) {
+    m_dropping = true;
+  }
+  m_flushDeadline = std::chrono::steady_clock::now() + FLUSH_TIMEOUT;
+  m_queue.close();
+  m_thread.join();
+}
+
+void KitchenOutbox::run() {
+  while (std::optional<Communication::Message> message = m_queue.pop()) {
+    auto warnAt = std::chrono::steady_clock::now() + STALL_WARNING;
+    while (!m_dropping) {
+      try {
+        if (m_ipcManager.sendToKitchen(m_kitchenId, *message, SEND_WAIT)) {
+          break;
+        }
+      } catch (const std::exception &e) {
+        LOG_ERROR("Dropping the messages left for kitchen " +
+                  std::to_string(m_kitchenId) + ": " + e.what());
+        m_dropping = true;
+        break;
+      }
+
+      auto now = std::chrono::steady_clock::now();
+      if (now >= m_flushDeadline.load()) {
+        LOG_ERROR("Dropping the messages left for kitchen " +
+                  std::to_string(m_kitchenId) + ": its inbox stayed full");
+        m_dropping = true;
+      } else if (now >= warnAt) {
+        LOG_WARN("Kitchen " + std::to_string(m_kitchenId) +
+                 " is not taking messages, still waiting");
+        warnAt = std::chrono::steady_clock::time_point::max();
+      }
+    }
+  }
+}
+} // namespace Plazza::Reception
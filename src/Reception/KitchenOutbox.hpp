@@ -0,0 +1,82 @@
+/**
+ * @file KitchenOutbox.hpp
+ * @brief Defines the KitchenOutbox class, the sender stage of a kitchen.
+ */
+
+#pragma once
+
+#include "Communication/IPCManager.hpp"
+#include "Communication/Message.hpp"
+#include "Core/BoundedQueue.hpp"
+#include "Core/Thread.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Plazza::Reception {
+/**
+ * @class KitchenOutbox
+ * @brief Sends the messages for one kitchen from a thread of its own.
+ * Messages are sent in the order they were posted. When the inbox of the
+ * kitchen is full, the outbox blocks until there is room instead of failing,
+ * waking up only to check whether it was closed, so a slow kitchen only holds
+ * back its own messages. Posting never blocks: it fails once the outbox
+ * itself is full, and the caller keeps the message. A posted message is only
+ * dropped when the kitchen is removed, whose orders the kitchen manager then
+ * recovers, when a flush on shutdown outlasts its deadline, or when the
+ * channel of the kitchen fails.
+ */
+class KitchenOutbox {
+public:
+  /**
+   * @brief Constructs a KitchenOutbox instance and starts its thread.
+   * @param ipcManager The IPC manager holding the channel of the kitchen.
+   * @param kitchenId The ID of the kitchen.
+   * @param capacity How many messages may wait in the outbox.
+   */
+  KitchenOutbox(Communication::IPCManager &ipcManager, uint32_t kitchenId,
+                size_t capacity);
+
+  /**
+   * @brief Destructor that drops the waiting messages and stops the thread.
+   */
+  ~KitchenOutbox();
+
+  KitchenOutbox(const KitchenOutbox &) = delete;
+  KitchenOutbox &operator=(const KitchenOutbox &) = delete;
+
+  /**
+   * @brief Queues a message for the kitchen, without blocking.
+   * @param message The message to send.
+   * @return True if the message was queued, false if the outbox is full or
+   * closed.
+   */
+  bool post(const Communication::Message &message);
+
+  /**
+   * @brief Closes the outbox and waits for its thread to stop.
+   * @param flush If true, the waiting messages are sent first, for at most
+   * FLUSH_TIMEOUT, otherwise they are dropped.
+   */
+  void close(bool flush);
+
+private:
+  /**
+   * @brief Sends the posted messages until the outbox is closed.
+   */
+  void run();
+
+  /// Longest wait for room in the inbox before checking for a close.
+  static constexpr std::chrono::milliseconds SEND_WAIT{20};
+  static constexpr std::chrono::seconds STALL_WARNING{2};
+  static constexpr std::chrono::seconds FLUSH_TIMEOUT{2};
+
+  Communication::IPCManager &m_ipcManager;
+  uint32_t m_kitchenId;
+  Core::BoundedQueue<Communication::Message> m_queue;
+  std::atomic<bool> m_dropping{false};
+  std::atomic<std::chrono::steady_clock::time_point> m_flushDeadline{
+      std::chrono::steady_clock::time_point::max()};
+  Core::Thread m_thread;
+};
+} // namespace Plazza::Reception
@@ -0,0 +1,152 @@
+/**
+ * @file OrderIngest.cpp
+ * @brief Implements the OrderIngest class.
+ */
+
+#include "Reception/OrderIngest.hpp"
+#include "Core/MappedFile.hpp"
+#include "Logger/Logger.hpp"
+#include "Reception/OrderParser.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+
+namespace Plazza::Reception {
+OrderIngest::OrderIngest(KitchenManager &kitchenManager)
+    : m_kitchenManager(kitchenManager) {}
+
+IngestReport OrderIngest::ingestFile(const std::string &path) {
+  Core::MappedFile file(path);
+  start();
+  submit(file.view(), nullptr);
+  return finish();
+}
+
+IngestReport OrderIngest::ingestStream(int fd) {
+  start();
+
+  std::string pending;
+  while (true) {
+    size_t filled = pending.size();
+    pending.resize(filled + READ_SIZE);
+    ssize_t count = ::read(fd, pending.data() + filled, READ_SIZE);
+    if (count == -1 && errno == EINTR) {
+      pending.resize(filled);
+      continue;
+    }
+    if (count == -1) {
+      LOG_ERROR(std::string("Failed to read orders: ") +
+                std::strerror(errno));
+    }
+    pending.resize(filled + static_cast<size_t>(std::max<ssize_t>(count, 0)));
+    if (count <= 0) {
+      break;
+    }
+
+    size_t last = pending.find_last_of(";\n");
+    if (last == std::string::npos) {
+      continue;
+    }
+    auto block = std::make_shared<const std::string>(pending, 0, last + 1);
+    pending.erase(0, last + 1);
+    submit(*block, block);
+  }
+
+  if (!pending.empty()) {
+    auto block = std::make_shared<const std::string>(std::move(pending));
+    submit(*block, block);
+  }
+  return finish();
+}
+
+void OrderIngest::start() {
+  m_report = {};
+  m_start = std::chrono::steady_clock::now();
+  m_pieces = std::make_unique<Core::BoundedQueue<Piece>>(MAX_PIECES_IN_FLIGHT);
+  m_batches = std::make_unique<Core::BoundedQueue<std::future<Batch>>>(
+      MAX_PIECES_IN_FLIGHT);
+
+  unsigned workers =
+      std::clamp(std::thread::hardware_concurrency(), 1u, MAX_WORKERS);
+  m_workers.clear();
+  m_workers.resize(workers);
+  for (auto &worker : m_workers) {
+    worker.start([this]() { parsePieces(); });
+  }
+  m_dispatcher.start([this]() { dispatchBatches(); });
+}
+
+void OrderIngest::submit(std::string_view block,
+                         const std::shared_ptr<const std::string> &owner) {
+  while (!block.empty()) {
+    size_t cut = block.size();
+    if (block.size() > PIECE_SIZE) {
+      cut = block.find_first_of(";\n", PIECE_SIZE);
+      cut = cut == std::string_view::npos ? block.size() : cut + 1;
+    }
+
+    Piece piece;
+    piece.text = block.substr(0, cut);
+    piece.owner = owner;
+    m_batches->push(piece.batch.get_future());
+    m_pieces->push(std::move(piece));
+    block.remove_prefix(cut);
+  }
+}
+
+IngestReport OrderIngest::finish() {
+  m_pieces->close();
+  for (auto &worker : m_workers) {
+    worker.join();
+  }
+  m_batches->close();
+  m_dispatcher.join();
+
+  m_report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - m_start);
+  return m_report;
+}
+
+void OrderIngest::parsePieces() {
+  while (std::optional<Piece> piece = m_pieces->pop()) {
+    try {
+      Batch batch;
+      std::vector<ParseError> errors;
+      OrderParser::scanBlock(piece->text, batch.runs, errors);
+      for (const auto &error : errors) {
+        LOG_WARN("Skipping invalid order '" + std::string(error.segment) +
+                 "': " + OrderParser::describe(error.code));
+      }
+      batch.invalid = errors.size();
+      piece->batch.set_value(std::move(batch));
+    } catch (...) {
+      piece->batch.set_exception(std::current_exception());
+    }
+  }
+}
+
+void OrderIngest::dispatchBatches() {
+  while (std::optional<std::future<Batch>> pending = m_batches->pop()) {
+    try {
+      Batch batch = pending->get();
+      m_report.invalid += batch.invalid;
+      if (batch.runs.empty()) {
+        continue;
+      }
+
+      OrderParser::assignOrderIds(batch.runs);
+      for (const auto &run : batch.runs) {
+        m_report.orders += run.count;
+      }
+      DispatchReport dispatch = m_kitchenManager.distributeOrder(batch.runs);
+      m_report.dispatched += dispatch.dispatched;
+      m_report.deferred += dispatch.deferred;
+      m_report.rejected += dispatch.rejected;
+    } catch (const std::exception &e) {
+      LOG_ERROR(std::string("Failed to ingest orders: ") + e.what());
+    }
+  }
+}
+} // namespace Plazza::Reception
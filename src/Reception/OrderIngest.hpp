@@ -0,0 +1,133 @@
+/**
+ * @file OrderIngest.hpp
+ * @brief Defines the OrderIngest class for feeding bulk orders from a file or
+ * a pipe to the kitchens.
+ */
+
+#pragma once
+
+#include "Core/BoundedQueue.hpp"
+#include "Core/Thread.hpp"
+#include "Reception/KitchenManager.hpp"
+#include "Reception/OrderRun.hpp"
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Plazza::Reception {
+/**
+ * @struct IngestReport
+ * @brief Outcome of ingesting a file or a pipe of orders.
+ */
+struct IngestReport {
+  uint64_t orders = 0;     ///< Pizzas parsed.
+  uint64_t invalid = 0;    ///< Orders skipped because they did not parse.
+  uint64_t dispatched = 0; ///< Pizzas sent to a kitchen or the order table.
+  uint64_t deferred = 0;   ///< Pizzas waiting in the reception queue.
+  uint64_t rejected = 0;   ///< Pizzas dropped because the queue is full.
+  std::chrono::milliseconds duration{0};
+};
+
+/**
+ * @class OrderIngest
+ * @brief Feeds bulk orders to the kitchen manager.
+ * The input is cut into pieces at order separators, even inside long lines.
+ * Pieces are parsed in parallel by worker threads while a dispatcher thread
+ * hands the parsed runs to the kitchen manager in input order, so parsing
+ * overlaps with the messages sent to the kitchens. Bounded queues between the
+ * stages keep the memory in flight bounded when the kitchens fall behind.
+ * Invalid orders are skipped and logged.
+ */
+class OrderIngest {
+public:
+  /**
+   * @brief Constructs an OrderIngest instance.
+   * @param kitchenManager The kitchen manager the orders are given to.
+   */
+  explicit OrderIngest(KitchenManager &kitchenManager);
+
+  /**
+   * @brief Ingests the orders of a file, mapped in memory.
+   * @param path The path of the file.
+   * @return How many orders were parsed, skipped and dispatched.
+   * @throws Exceptions::ArgumentException if the file cannot be mapped.
+   */
+  IngestReport ingestFile(const std::string &path);
+
+  /**
+   * @brief Ingests the orders read from a descriptor until its end, such as a
+   * pipe.
+   * @param fd The descriptor to read.
+   * @return How many orders were parsed, skipped and dispatched.
+   */
+  IngestReport ingestStream(int fd);
+
+private:
+  /**
+   * @struct Batch
+   * @brief The runs parsed from a piece of input.
+   */
+  struct Batch {
+    std::vector<OrderRun> runs;
+    uint64_t invalid = 0;
+  };
+
+  /**
+   * @struct Piece
+   * @brief A piece of input waiting to be parsed.
+   */
+  struct Piece {
+    std::string_view text;
+    std::shared_ptr<const std::string> owner; ///< Keeps text alive, if read.
+    std::promise<Batch> batch;
+  };
+
+  /**
+   * @brief Starts the parser workers and the dispatcher.
+   */
+  void start();
+
+  /**
+   * @brief Cuts a block of input into pieces and queues them for parsing.
+   * Blocks while too many pieces are in flight.
+   * @param block The input, ending at an order separator or at the end.
+   * @param owner The buffer holding the block, or null if it is mapped.
+   */
+  void submit(std::string_view block,
+              const std::shared_ptr<const std::string> &owner);
+
+  /**
+   * @brief Waits for every queued piece to be parsed and dispatched.
+   * @return The report of the ingestion.
+   */
+  IngestReport finish();
+
+  /**
+   * @brief Parses queued pieces until the piece queue is closed.
+   */
+  void parsePieces();
+
+  /**
+   * @brief Dispatches parsed batches in input order until the batch queue is
+   * closed.
+   */
+  void dispatchBatches();
+
+  static constexpr size_t PIECE_SIZE = 64 * 1024;
+  static constexpr size_t READ_SIZE = 1024 * 1024;
+  static constexpr size_t MAX_PIECES_IN_FLIGHT = 64;
+  static constexpr unsigned MAX_WORKERS = 8;
+
+  KitchenManager &m_kitchenManager;
+  std::unique_ptr<Core::BoundedQueue<Piece>> m_pieces;
+  std::unique_ptr<Core::BoundedQueue<std::future<Batch>>> m_batches;
+  std::vector<Core::Thread> m_workers;
+  Core::Thread m_dispatcher;
+  IngestReport m_report;
+  std::chrono::steady_clock::time_point m_start;
+};
+} // namespace Plazza::Reception
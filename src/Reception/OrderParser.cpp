@@ -1,73 +1,241 @@
 #include "Reception/OrderParser.hpp"
 #include "Core/Pizza.hpp"
-#include "Exceptions/ParserException.hpp"
-#include <sstream>
+#include <chrono>
 
 namespace Plazza::Reception {
-const std::regex
-    OrderParser::ORDER_REGEX(R"(([a-zA-Z]+)\s+(S|M|L|XL|XXL)\s+x(\d+))",
-                             std::regex_constants::icase);
-
-uint32_t OrderParser::m_nextOrderId = 1;
-
-std::vector<Communication::PizzaOrder>
-OrderParser::parseOrder(const std::string &input) {
-  std::vector<Communication::PizzaOrder> orders;
-
-  std::istringstream stream(input);
-  std::string orderPart;
-
-  while (std::getline(stream, orderPart, ';')) {
-    orderPart.erase(0, orderPart.find_first_not_of(" \t"));
-    orderPart.erase(orderPart.find_last_not_of(" \t") + 1);
-
-    if (orderPart.empty())
-      continue;
-
-    std::smatch match;
-    if (std::regex_match(orderPart, match, ORDER_REGEX)) {
-      try {
-        std::string orderTypeString = match[1].str();
-        std::string orderSizeString = match[2].str();
-        uint32_t orderQuantity = std::stoul(match[3].str());
-
-        Core::PizzaType type = Core::pizzaTypeFromString(orderTypeString);
-        Core::PizzaSize size = Core::pizzaSizeFromString(orderSizeString);
-
-        for (uint32_t i = 0; i < orderQuantity; ++i) {
-          Communication::PizzaOrder order;
-          order.type = type;
-          order.size = size;
-          order.quantity = 1;
-          order.orderId = m_nextOrderId++;
-          orders.push_back(order);
-        }
-
-      } catch (const std::exception &e) {
-        throw Exceptions::ParserException("Failed to parse order part '" +
-                                          orderPart + "': " + e.what());
+namespace {
+bool isBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' ||
+         c == '\f';
+}
+
+bool isLetter(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool skipBlanks(std::string_view text, size_t &pos) {
+  size_t start = pos;
+  while (pos < text.size() && isBlank(text[pos])) {
+    ++pos;
+  }
+  return pos > start;
+}
+
+std::string_view readWord(std::string_view text, size_t &pos) {
+  size_t start = pos;
+  while (pos < text.size() && isLetter(text[pos])) {
+    ++pos;
+  }
+  return text.substr(start, pos - start);
+}
+
+bool readNumber(std::string_view text, size_t &pos, uint64_t limit,
+                uint64_t &value) {
+  value = 0;
+  bool inRange = true;
+  while (pos < text.size() && isDigit(text[pos])) {
+    if (inRange) {
+      value = value * 10 + static_cast<uint64_t>(text[pos] - '0');
+      inRange = value <= limit;
+    }
+    ++pos;
+  }
+  return inRange;
+}
+} // namespace
+
+std::atomic<uint64_t> OrderParser::m_nextOrderId{1};
+
+ParseError OrderParser::parse(std::string_view input,
+                              std::vector<OrderRun> &runs) {
+  size_t firstRun = runs.size();
+  uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now().time_since_epoch())
+                     .count();
+
+  size_t start = 0;
+  while (start <= input.size()) {
+    size_t end = input.find(';', start);
+    if (end == std::string_view::npos) {
+      end = input.size();
+    }
+
+    size_t first = start;
+    size_t last = end;
+    while (first < last && isBlank(input[first])) {
+      ++first;
+    }
+    while (last > first && isBlank(input[last - 1])) {
+      --last;
+    }
+
+    if (first < last) {
+      ParseError error =
+          parseSegment(input.substr(first, last - first), first, now, runs);
+      if (error) {
+        runs.erase(runs.begin() + firstRun, runs.end());
+        return error;
       }
-    } else {
-      throw Exceptions::ParserException("Invalid order format: '" + orderPart +
-                                        "'. Expected format: "
-                                        "<PizzaType> <Size> x<Quantity>");
     }
+    start = end + 1;
   }
 
-  if (orders.empty()) {
-    throw Exceptions::ParserException(
-        "No valid pizza orders found in input: '" + input + "'");
+  if (runs.size() == firstRun) {
+    return {ParseErrorCode::NoOrder, 0, input};
+  }
+  assignOrderIds(runs, firstRun);
+  return {};
+}
+
+void OrderParser::scanBlock(std::string_view block, std::vector<OrderRun> &runs,
+                            std::vector<ParseError> &errors) {
+  uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now().time_since_epoch())
+                     .count();
+
+  size_t start = 0;
+  while (start < block.size()) {
+    size_t end = block.find_first_of(";\n", start);
+    if (end == std::string_view::npos) {
+      end = block.size();
+    }
+
+    size_t first = start;
+    size_t last = end;
+    while (first < last && isBlank(block[first])) {
+      ++first;
+    }
+    while (last > first && isBlank(block[last - 1])) {
+      --last;
+    }
+
+    if (first < last) {
+      ParseError error =
+          parseSegment(block.substr(first, last - first), first, now, runs);
+      if (error) {
+        errors.push_back(error);
+      }
+    }
+    start = end + 1;
+  }
+}
+
+void OrderParser::assignOrderIds(std::vector<OrderRun> &runs, size_t from) {
+  uint64_t total = 0;
+  for (size_t i = from; i < runs.size(); ++i) {
+    total += runs[i].count;
+  }
+
+  uint64_t orderId = m_nextOrderId.fetch_add(total);
+  for (size_t i = from; i < runs.size(); ++i) {
+    runs[i].firstOrderId = orderId;
+    orderId += runs[i].count;
+  }
+}
+
+ParseError OrderParser::parseSegment(std::string_view segment, size_t base,
+                                     uint64_t now,
+                                     std::vector<OrderRun> &runs) {
+  size_t pos = 0;
+  auto fail = [&](ParseErrorCode code, size_t at) {
+    return ParseError{code, base + at, segment};
+  };
+
+  std::string_view typeName = readWord(segment, pos);
+  if (typeName.empty()) {
+    return fail(ParseErrorCode::ExpectedType, pos);
+  }
+  std::optional<Core::PizzaType> type = Core::findPizzaType(typeName);
+  if (!type) {
+    return fail(ParseErrorCode::UnknownType, 0);
+  }
+
+  if (!skipBlanks(segment, pos)) {
+    return fail(ParseErrorCode::ExpectedSize, pos);
+  }
+  size_t sizeStart = pos;
+  std::string_view sizeName = readWord(segment, pos);
+  if (sizeName.empty()) {
+    return fail(ParseErrorCode::ExpectedSize, pos);
+  }
+  std::optional<Core::PizzaSize> size = Core::findPizzaSize(sizeName);
+  if (!size) {
+    return fail(ParseErrorCode::UnknownSize, sizeStart);
+  }
+
+  if (!skipBlanks(segment, pos) || pos == segment.size() ||
+      (segment[pos] != 'x' && segment[pos] != 'X')) {
+    return fail(ParseErrorCode::ExpectedQuantity, pos);
+  }
+  size_t quantityStart = ++pos;
+  uint64_t quantity = 0;
+  bool inRange = readNumber(segment, pos, MAX_QUANTITY, quantity);
+  if (pos == quantityStart) {
+    return fail(ParseErrorCode::ExpectedQuantity, pos);
+  }
+  if (!inRange || quantity == 0) {
+    return fail(ParseErrorCode::InvalidQuantity, quantityStart);
+  }
+
+  uint64_t deadline = 0;
+  size_t trailingStart = pos;
+  if (skipBlanks(segment, pos) && pos < segment.size() &&
+      segment[pos] == '@') {
+    size_t deadlineStart = ++pos;
+    uint64_t seconds = 0;
+    if (!readNumber(segment, pos, UINT32_MAX, seconds) ||
+        pos == deadlineStart) {
+      return fail(ParseErrorCode::InvalidDeadline, deadlineStart);
+    }
+    deadline = now + seconds * 1000000000ULL;
+    trailingStart = pos;
+  }
+  if (trailingStart != segment.size()) {
+    return fail(ParseErrorCode::TrailingInput, trailingStart);
+  }
+
+  runs.push_back({*type, *size, static_cast<uint32_t>(quantity), 0, deadline});
+  return {};
+}
+
+std::string OrderParser::describe(const ParseError &error) {
+  if (error.code == ParseErrorCode::NoOrder) {
+    return "No valid pizza orders found in input: '" +
+           std::string(error.segment) + "'";
   }
 
-  return orders;
+  return "Invalid order format: '" + std::string(error.segment) +
+         "' at column " + std::to_string(error.offset + 1) + ", " +
+         describe(error.code) +
+         ". Expected format: <PizzaType> <Size> x<Quantity> "
+         "[@<DeadlineSeconds>]";
 }
 
-bool OrderParser::isValidOrder(const std::string &input) {
-  try {
-    parseOrder(input);
-    return true;
-  } catch (...) {
-    return false;
+std::string OrderParser::describe(ParseErrorCode code) {
+  switch (code) {
+  case ParseErrorCode::None:
+    return "no error";
+  case ParseErrorCode::NoOrder:
+    return "no order";
+  case ParseErrorCode::ExpectedType:
+    return "expected a pizza type";
+  case ParseErrorCode::UnknownType:
+    return "unknown pizza type";
+  case ParseErrorCode::ExpectedSize:
+    return "expected a size";
+  case ParseErrorCode::UnknownSize:
+    return "unknown size";
+  case ParseErrorCode::ExpectedQuantity:
+    return "expected x<Quantity>";
+  case ParseErrorCode::InvalidQuantity:
+    return "quantity must be between 1 and " + std::to_string(MAX_QUANTITY);
+  case ParseErrorCode::InvalidDeadline:
+    return "invalid deadline";
+  case ParseErrorCode::TrailingInput:
+    return "unexpected characters";
   }
+  return "unknown error";
 }
 } // namespace Plazza::Reception
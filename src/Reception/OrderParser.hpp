@@ -5,37 +5,119 @@
 
 #pragma once
 
-#include "Communication/Serialization.hpp"
-#include <regex>
+#include "Reception/OrderRun.hpp"
+#include <atomic>
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Plazza::Reception {
+/**
+ * @enum ParseErrorCode
+ * @brief Enum representing why an order line was rejected.
+ */
+enum class ParseErrorCode {
+  None,             ///< The line was parsed.
+  NoOrder,          ///< The line holds no order.
+  ExpectedType,     ///< An order does not start with a pizza type.
+  UnknownType,      ///< The pizza type is not on the menu.
+  ExpectedSize,     ///< The pizza type is not followed by a size.
+  UnknownSize,      ///< The size is not S, M, L, XL or XXL.
+  ExpectedQuantity, ///< The size is not followed by x<Quantity>.
+  InvalidQuantity,  ///< The quantity is zero or too large.
+  InvalidDeadline,  ///< The deadline after @ is missing or too large.
+  TrailingInput     ///< Unexpected characters follow the order.
+};
+
+/**
+ * @struct ParseError
+ * @brief Describes where and why an order line was rejected.
+ */
+struct ParseError {
+  ParseErrorCode code = ParseErrorCode::None;
+  size_t offset = 0;        ///< Position in the line where parsing stopped.
+  std::string_view segment; ///< The rejected order, viewing the line.
+
+  /**
+   * @brief Checks if the line was parsed.
+   * @return True if there is no error, false otherwise.
+   */
+  explicit operator bool() const { return code != ParseErrorCode::None; }
+};
+
 /**
  * @class OrderParser
  * @brief Parses pizza orders from a string input.
+ * Lines are scanned once, in place, without regular expressions or
+ * temporary strings. Each order of a line becomes one run, whatever its
+ * quantity.
  */
 class OrderParser {
 public:
   /**
-   * @brief Parses a pizza order from a string input.
-   * @param input The input string containing the order.
-   * @return A vector of PizzaOrder objects representing the parsed orders.
-   * @throws Exceptions::ParserException if the input format is invalid.
-   * @throws Exceptions::ArgumentException if the pizza type or size is invalid.
+   * @brief Parses a pizza order line without throwing.
+   * Either every order of the line is appended, or none is. Reusing the same
+   * vector across lines avoids allocations once it has grown.
+   * @param input The line containing the orders, separated by ';'.
+   * @param runs The vector the runs of the parsed orders are appended to.
+   * @return The error that rejected the line, which is false if there is none.
+   */
+  static ParseError parse(std::string_view input, std::vector<OrderRun> &runs);
+
+  /**
+   * @brief Parses a block of order lines without throwing, skipping invalid
+   * orders.
+   * Orders are separated by ';' or new lines, so a block can be cut at any
+   * separator and its parts parsed on different threads. Order IDs are left
+   * to assignOrderIds().
+   * @param block The orders to parse.
+   * @param runs The vector the runs of the valid orders are appended to.
+   * @param errors The vector the errors of the invalid orders are appended
+   * to, with offsets in the block.
+   */
+  static void scanBlock(std::string_view block, std::vector<OrderRun> &runs,
+                        std::vector<ParseError> &errors);
+
+  /**
+   * @brief Gives consecutive order IDs to runs.
+   * IDs are 64-bit, so they never wrap within a session, even though
+   * rejected orders use up their IDs too.
+   * @param runs The runs to number.
+   * @param from Index of the first run to number.
+   */
+  static void assignOrderIds(std::vector<OrderRun> &runs, size_t from = 0);
+
+  /**
+   * @brief Describes a parse error.
+   * @param error The error to describe.
+   * @return A human readable description, quoting the rejected order.
    */
-  static std::vector<Communication::PizzaOrder>
-  parseOrder(const std::string &input);
+  static std::string describe(const ParseError &error);
 
   /**
-   * @brief Validates the format of a pizza order string.
-   * @param input The input string to validate.
-   * @return True if the input is a valid order format, false otherwise.
+   * @brief Describes a parse error code.
+   * @param code The code to describe.
+   * @return A short human readable reason.
    */
-  static bool isValidOrder(const std::string &input);
+  static std::string describe(ParseErrorCode code);
 
 private:
-  static const std::regex ORDER_REGEX;
-  static uint32_t m_nextOrderId;
+  /**
+   * @brief Parses a single order, trimmed of surrounding blanks, into a run
+   * without an order ID.
+   * @param segment The order to parse.
+   * @param base Offset of the order in the line.
+   * @param now Steady clock time of the parse, in nanoseconds.
+   * @param runs The vector the run of the parsed order is appended to.
+   * @return The error that rejected the order, which is false if there is
+   * none.
+   */
+  static ParseError parseSegment(std::string_view segment, size_t base,
+                                 uint64_t now, std::vector<OrderRun> &runs);
+
+  static constexpr uint32_t MAX_QUANTITY = 10000000;
+
+  static std::atomic<uint64_t> m_nextOrderId;
 };
 } // namespace Plazza::Reception
@@ -0,0 +1,62 @@
+/**
+ * @file OrderRun.hpp
+ * @brief Defines the OrderRun struct, a run of identical pizza orders.
+ */
+
+#pragma once
+
+#include "Communication/Serialization.hpp"
+#include <cstdint>
+
+namespace Plazza::Reception {
+/**
+ * @struct OrderRun
+ * @brief Identical pizzas ordered together, with consecutive order IDs.
+ * A run stands for count orders of one pizza each without storing them, so
+ * bulk orders take the same memory whatever their quantity.
+ */
+struct OrderRun {
+  Core::PizzaType type = Core::PizzaType::Regina;
+  Core::PizzaSize size = Core::PizzaSize::S;
+  uint32_t count = 0;
+  uint64_t firstOrderId = 0;
+  uint64_t deadline = 0; ///< Steady clock nanoseconds, 0 if none.
+
+  /**
+   * @brief Makes a run of a single order.
+   * @param order The order.
+   * @return A run holding only this order.
+   */
+  static OrderRun of(const Communication::PizzaOrder &order) {
+    return {order.type, order.size, 1, order.orderId, order.deadline};
+  }
+
+  /**
+   * @brief Gets the first order of the run.
+   * @return The order, for one pizza.
+   */
+  [[nodiscard]] Communication::PizzaOrder front() const {
+    Communication::PizzaOrder order;
+    order.type = type;
+    order.size = size;
+    order.quantity = 1;
+    order.orderId = firstOrderId;
+    order.deadline = deadline;
+    return order;
+  }
+
+  /**
+   * @brief Removes the first order of the run.
+   */
+  void popFront() {
+    ++firstOrderId;
+    --count;
+  }
+
+  /**
+   * @brief Checks if the run has no order left.
+   * @return True if the run is empty, false otherwise.
+   */
+  [[nodiscard]] bool empty() const { return count == 0; }
+};
+} // namespace Plazza::Reception
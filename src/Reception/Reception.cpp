@@ -1,15 +1,23 @@
 #include "Reception/Reception.hpp"
 #include "Logger/Logger.hpp"
+#include "Reception/OrderIngest.hpp"
 #include "Reception/OrderParser.hpp"
 #include <iostream>
+#include <sstream>
+#include <unistd.h>
 
 namespace Plazza::Reception {
-Reception::Reception(double timeMultiplier, uint32_t cooksPerKitchen,
-                     std::chrono::milliseconds stockRegenTime)
-    : m_kitchenManager(std::make_unique<KitchenManager>(
-          cooksPerKitchen, stockRegenTime, timeMultiplier)) {}
+Reception::Reception(const Settings &settings)
+    : m_kitchenManager(std::make_unique<KitchenManager>(settings)),
+      m_ordersPath(settings.ordersPath) {}
+
+Reception::~Reception() { stopPipeline(); }
 
 void Reception::run() {
+  m_parser.start([this]() { parseOrders(); });
+  m_router.start([this]() { routeOrders(); });
+  ingestOrders();
+
   std::string input;
   while (m_running) {
     if (!std::getline(std::cin, input)) {
@@ -20,7 +28,79 @@ void Reception::run() {
       processCommand(input);
     }
   }
-  m_kitchenManager->cleanup();
+  stopPipeline();
+  DrainReport report = m_kitchenManager->drain();
+  std::cout << "Drained in " << report.duration.count() << " ms: "
+            << report.completed << " pizzas completed, " << report.abandoned
+            << " abandoned in kitchens, " << report.queued
+            << " never dispatched" << std::endl;
+}
+
+void Reception::parseOrders() {
+  while (std::optional<std::string> line = m_orderLines.pop()) {
+    std::vector<OrderRun> runs;
+    ParseError error = OrderParser::parse(*line, runs);
+    if (error) {
+      LOG_ERROR("Error: " + OrderParser::describe(error));
+      continue;
+    }
+    m_parsedOrders.push(std::move(runs));
+  }
+  m_parsedOrders.close();
+}
+
+void Reception::routeOrders() {
+  while (std::optional<std::vector<OrderRun>> runs = m_parsedOrders.pop()) {
+    try {
+      DispatchReport report = m_kitchenManager->distributeOrder(*runs);
+      if (report.dispatched + report.deferred > 0) {
+        LOG_INFO("Order placed: " +
+                 std::to_string(report.dispatched + report.deferred) +
+                 " pizzas");
+      }
+      if (report.deferred > 0) {
+        LOG_WARN("Kitchens are full, " + std::to_string(report.deferred) +
+                 " pizzas will be dispatched when capacity frees up");
+      }
+      if (report.rejected > 0) {
+        LOG_WARN("Order queue is full, " + std::to_string(report.rejected) +
+                 " pizzas were rejected");
+      }
+    } catch (const std::exception &e) {
+      LOG_ERROR(std::string("Error: ") + e.what());
+    }
+  }
+}
+
+void Reception::stopPipeline() {
+  m_orderLines.close();
+  m_parser.join();
+  m_parsedOrders.close();
+  m_router.join();
+}
+
+void Reception::ingestOrders() {
+  if (m_ordersPath.empty()) {
+    return;
+  }
+
+  OrderIngest ingest(*m_kitchenManager);
+  IngestReport report;
+  if (m_ordersPath == "-") {
+    report = ingest.ingestStream(STDIN_FILENO);
+    m_running = false;
+  } else {
+    report = ingest.ingestFile(m_ordersPath);
+  }
+  std::cout << "Ingested " << report.orders << " pizzas in "
+            << report.duration.count() << " ms: " << report.dispatched
+            << " dispatched, " << report.deferred << " queued, "
+            << report.rejected << " rejected, " << report.invalid
+            << " invalid orders skipped" << std::endl;
+
+  if (m_ordersPath == "-") {
+    m_kitchenManager->waitUntilIdle();
+  }
 }
 
 void Reception::processCommand(const std::string &command) {
@@ -38,15 +118,23 @@ void Reception::processCommand(const std::string &command) {
     return;
   }
 
-  try {
-    std::vector<Communication::PizzaOrder> orders =
-        OrderParser::parseOrder(trimmedCommand);
-    if (!orders.empty()) {
-      m_kitchenManager->distributeOrder(orders);
-      LOG_INFO("Order placed: " + std::to_string(orders.size()) + " pizzas");
+  if (trimmedCommand.rfind("cooks ", 0) == 0) {
+    try {
+      std::istringstream arguments(trimmedCommand.substr(6));
+      std::string first;
+      std::string second;
+      arguments >> first >> second;
+      if (second.empty()) {
+        m_kitchenManager->resizeCooks(std::stoul(first));
+      } else {
+        m_kitchenManager->resizeCooks(std::stoul(second), first);
+      }
+    } catch (const std::exception &e) {
+      LOG_ERROR(std::string("Error: ") + e.what());
     }
-  } catch (const std::exception &e) {
-    LOG_ERROR(std::string("Error: ") + e.what());
+    return;
   }
+
+  m_orderLines.push(trimmedCommand);
 }
 } // namespace Plazza::Reception
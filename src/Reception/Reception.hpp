@@ -5,26 +5,40 @@
 
 #pragma once
 
+#include "Core/BoundedQueue.hpp"
+#include "Core/Thread.hpp"
 #include "Reception/KitchenManager.hpp"
+#include "Reception/OrderRun.hpp"
+#include "Reception/Settings.hpp"
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Plazza::Reception {
 /**
  * @class Reception
  * @brief Manages the reception process.
+ * Order lines go through a pipeline: a parser thread turns them into runs and
+ * a router thread hands the runs to the kitchen manager, whose kitchen
+ * outboxes send them. The thread reading the input only queues order lines,
+ * so commands such as status and exit are handled at once even while orders
+ * are being routed.
  */
 class Reception {
 public:
   /**
    * @brief Constructs a Reception instance.
-   * @param timeMultiplier Multiplier for cooking time to simulate different
-   * cooking speeds.
-   * @param cooksPerKitchen Number of cooks per kitchen.
-   * @param stockRestockTime Time interval for stock replenishment.
+   * @param settings Runtime settings of the reception and its kitchens.
    */
-  Reception(double timeMultiplier, uint32_t cooksPerKitchen,
-            std::chrono::milliseconds stockRestockTime);
+  explicit Reception(const Settings &settings);
+
+  /**
+   * @brief Destructor that stops the order pipeline.
+   */
+  ~Reception();
+
+  Reception(const Reception &) = delete;
+  Reception &operator=(const Reception &) = delete;
 
   /**
    * @brief Runs the reception process, handling user input and distributing
@@ -33,6 +47,29 @@ public:
   void run();
 
 private:
+  /**
+   * @brief Ingests the orders of the file given in the settings, if any.
+   * Orders read from the standard input are all cooked before returning, as
+   * no command can follow them.
+   */
+  void ingestOrders();
+
+  /**
+   * @brief Parses queued order lines until the line queue is closed.
+   */
+  void parseOrders();
+
+  /**
+   * @brief Hands parsed orders to the kitchen manager until the order queue
+   * is closed.
+   */
+  void routeOrders();
+
+  /**
+   * @brief Closes the pipeline and waits for the orders in it to be routed.
+   */
+  void stopPipeline();
+
   /**
    * @brief Processes a command entered by the user.
    * @param command The command string to process.
@@ -40,7 +77,14 @@ private:
   void processCommand(const std::string &command);
 
 private:
+  static constexpr size_t PIPELINE_DEPTH = 256;
+
   std::unique_ptr<KitchenManager> m_kitchenManager;
+  std::string m_ordersPath;
   bool m_running = true;
+  Core::BoundedQueue<std::string> m_orderLines{PIPELINE_DEPTH};
+  Core::BoundedQueue<std::vector<OrderRun>> m_parsedOrders{PIPELINE_DEPTH};
+  Core::Thread m_parser;
+  Core::Thread m_router;
 };
 } // namespace Plazza::Reception
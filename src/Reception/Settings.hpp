@@ -0,0 +1,61 @@
+/**
+ * @file Settings.hpp
+ * @brief Defines the runtime settings of the reception.
+ */
+
+#pragma once
+
+#include "Kitchen/CookPool.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Plazza::Reception {
+/**
+ * @enum DispatchMode
+ * @brief Enum representing how orders reach the kitchens.
+ */
+enum class DispatchMode {
+  Push,       ///< The reception routes every order to a kitchen inbox.
+  SharedTable ///< Orders are published in shared memory, kitchens claim them.
+};
+
+/**
+ * @enum KitchenHosting
+ * @brief Enum representing where the kitchens run.
+ */
+enum class KitchenHosting {
+  Processes, ///< Each kitchen is a forked process, reached by message queues.
+  Threads    ///< Each kitchen is a thread of the reception, reached in memory.
+};
+
+/**
+ * @struct KitchenProfile
+ * @brief A kind of kitchen the reception can create.
+ */
+struct KitchenProfile {
+  std::string name;
+  uint32_t cooks = 1;
+  std::chrono::milliseconds restockTime{1000};
+  uint32_t initialStock = 5; ///< Units of each ingredient at opening.
+};
+
+/**
+ * @struct Settings
+ * @brief Runtime settings of the reception and of the kitchens it creates.
+ */
+struct Settings {
+  double timeMultiplier = 1.0;
+  uint32_t cooksPerKitchen = 1;
+  std::chrono::milliseconds stockRestockTime{1000};
+  DispatchMode dispatchMode = DispatchMode::Push;
+  Kitchen::CookModel cookModel = Kitchen::CookModel::Threads;
+  KitchenHosting kitchenHosting = KitchenHosting::Processes;
+  uint32_t maxKitchens = 32;
+  uint32_t maxQueuedRuns = 4096; ///< Runs of orders waiting for a kitchen.
+  std::chrono::milliseconds drainTimeout{5000};
+  std::vector<KitchenProfile> profiles; ///< Kinds of kitchens to create.
+  std::string ordersPath; ///< File of orders to ingest first, "-" for stdin.
+};
+} // namespace Plazza::Reception
@@ -1,17 +1,113 @@
 #include "Exceptions/ArgumentException.hpp"
 #include "Logger/Logger.hpp"
 #include "Reception/Reception.hpp"
+#include "Reception/Settings.hpp"
 #include <chrono>
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 static void printUsage(char **argv) {
   std::cerr << "Usage: " << argv[0]
             << " <time_multiplier> <cooks_per_kitchen> <stock_regen_time_ms>"
+            << " [options]" << std::endl
+            << "Options:" << std::endl
+            << "  --dispatch=push|shared  Route orders to kitchens or publish "
+               "them in a shared table"
+            << std::endl
+            << "  --cook-model=threads|coroutines  Run each cook on its own "
+               "thread or as a coroutine"
+            << std::endl
+            << "  --kitchens=processes|threads  Run each kitchen in its own "
+               "process or as a thread"
+            << std::endl
+            << "  --max-kitchens=N        Maximum number of kitchen processes"
+            << std::endl
+            << "  --max-queued=N          Maximum number of order runs waiting "
+               "for a kitchen"
+            << std::endl
+            << "  --drain-timeout=MS      How long kitchens may finish their "
+               "orders on exit"
+            << std::endl
+            << "  --profile=NAME:COOKS:RESTOCK_MS[:STOCK]  Add a kind of "
+               "kitchen to create"
+            << std::endl
+            << "  --orders=PATH           Ingest a file of orders, or the "
+               "standard input with -"
             << std::endl;
 }
 
+static uint32_t parsePositive(const std::string &option,
+                              const std::string &value) {
+  uint32_t number = std::stoul(value);
+  if (number == 0) {
+    throw Plazza::Exceptions::ArgumentException(option +
+                                                " must be a positive number");
+  }
+  return number;
+}
+
+static Plazza::Reception::KitchenProfile
+parseProfile(const std::string &value) {
+  std::vector<std::string> fields;
+  std::istringstream stream(value);
+  std::string field;
+  while (std::getline(stream, field, ':')) {
+    fields.push_back(field);
+  }
+  if (fields.size() < 3 || fields.size() > 4 || fields[0].empty()) {
+    throw Plazza::Exceptions::ArgumentException(
+        "--profile expects NAME:COOKS:RESTOCK_MS[:STOCK]");
+  }
+
+  Plazza::Reception::KitchenProfile profile;
+  profile.name = fields[0];
+  profile.cooks = parsePositive("--profile cooks", fields[1]);
+  profile.restockTime = std::chrono::milliseconds(std::stoul(fields[2]));
+  if (fields.size() == 4) {
+    profile.initialStock = std::stoul(fields[3]);
+  }
+  return profile;
+}
+
+static void applyOption(Plazza::Reception::Settings &settings,
+                        const std::string &option) {
+  if (option == "--dispatch=push") {
+    settings.dispatchMode = Plazza::Reception::DispatchMode::Push;
+  } else if (option == "--dispatch=shared") {
+    settings.dispatchMode = Plazza::Reception::DispatchMode::SharedTable;
+  } else if (option == "--cook-model=threads") {
+    settings.cookModel = Plazza::Kitchen::CookModel::Threads;
+  } else if (option == "--cook-model=coroutines") {
+    settings.cookModel = Plazza::Kitchen::CookModel::Coroutines;
+  } else if (option == "--kitchens=processes") {
+    settings.kitchenHosting = Plazza::Reception::KitchenHosting::Processes;
+  } else if (option == "--kitchens=threads") {
+    settings.kitchenHosting = Plazza::Reception::KitchenHosting::Threads;
+  } else if (option.rfind("--max-kitchens=", 0) == 0) {
+    settings.maxKitchens =
+        parsePositive("--max-kitchens", option.substr(option.find('=') + 1));
+  } else if (option.rfind("--max-queued=", 0) == 0) {
+    settings.maxQueuedRuns =
+        parsePositive("--max-queued", option.substr(option.find('=') + 1));
+  } else if (option.rfind("--drain-timeout=", 0) == 0) {
+    settings.drainTimeout = std::chrono::milliseconds(
+        std::stoul(option.substr(option.find('=') + 1)));
+  } else if (option.rfind("--profile=", 0) == 0) {
+    settings.profiles.push_back(
+        parseProfile(option.substr(option.find('=') + 1)));
+  } else if (option.rfind("--orders=", 0) == 0) {
+    settings.ordersPath = option.substr(option.find('=') + 1);
+    if (settings.ordersPath.empty()) {
+      throw Plazza::Exceptions::ArgumentException("--orders expects a path");
+    }
+  } else {
+    throw Plazza::Exceptions::ArgumentException("Unknown option: " + option);
+  }
+}
+
 int main(int argc, char **argv) {
-  if (argc != 4) {
+  if (argc < 4) {
     printUsage(argv);
     return 84;
   }
@@ -34,10 +130,16 @@ int main(int argc, char **argv) {
           "Number of cooks must be a positive number");
     }
 
-    auto stockRegenTime = std::chrono::milliseconds(stockRestockTime);
+    Plazza::Reception::Settings settings;
+    settings.timeMultiplier = timeMultiplier;
+    settings.cooksPerKitchen = cooksPerKitchen;
+    settings.stockRestockTime = std::chrono::milliseconds(stockRestockTime);
+
+    for (int i = 4; i < argc; ++i) {
+      applyOption(settings, argv[i]);
+    }
 
-    Plazza::Reception::Reception reception(timeMultiplier, cooksPerKitchen,
-                                           stockRegenTime);
+    Plazza::Reception::Reception reception(settings);
     reception.run();
 
   } catch (const std::exception &e) {
@@ -0,0 +1,87 @@
+/**
+ * @file RoutingTest.cpp
+ * @brief Checks that a kitchen is routed more pizzas once its cooks are
+ * resized, for kitchens run as processes and as threads.
+ *
+ * Usage: routing_test
+ * Exits with 1 if a resized kitchen is not given its new capacity.
+ */
+
+#include "Reception/KitchenManager.hpp"
+#include "Reception/OrderRun.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace Reception = Plazza::Reception;
+
+namespace {
+constexpr uint32_t COOKS = 1;
+constexpr uint32_t RESIZED_COOKS = 4;
+constexpr uint32_t PIZZAS_PER_COOK = 2;
+constexpr uint32_t ORDERS = 20;
+
+std::vector<Reception::OrderRun> makeRuns(uint64_t firstOrderId) {
+  Reception::OrderRun run;
+  run.type = Plazza::Core::PizzaType::Margarita;
+  run.size = Plazza::Core::PizzaSize::S;
+  run.count = ORDERS;
+  run.firstOrderId = firstOrderId;
+  return {run};
+}
+
+bool expect(const std::string &what, uint64_t actual, uint64_t expected) {
+  if (actual == expected) {
+    return true;
+  }
+  std::cerr << what << ": got " << actual << ", expected " << expected
+            << std::endl;
+  return false;
+}
+
+/**
+ * @brief Fills a single kitchen, resizes it, then checks the next batch
+ * fills the cooks it gained. Orders that do not fit are rejected rather
+ * than queued, and cooking never ends within the test, so the reports show
+ * the capacity of the kitchen.
+ */
+bool checkResize(Reception::KitchenHosting hosting) {
+  Reception::Settings settings;
+  settings.timeMultiplier = 1000.0;
+  settings.cooksPerKitchen = COOKS;
+  settings.kitchenHosting = hosting;
+  settings.maxKitchens = 1;
+  settings.maxQueuedRuns = 0;
+  settings.drainTimeout = std::chrono::milliseconds(100);
+
+  Reception::KitchenManager manager(settings);
+  bool passed = true;
+
+  Reception::DispatchReport before = manager.distributeOrder(makeRuns(1));
+  passed &= expect("dispatched before the resize", before.dispatched,
+                   COOKS * PIZZAS_PER_COOK);
+
+  manager.resizeCooks(RESIZED_COOKS);
+  Reception::DispatchReport after =
+      manager.distributeOrder(makeRuns(ORDERS + 1));
+  passed &= expect("dispatched after the resize", after.dispatched,
+                   (RESIZED_COOKS - COOKS) * PIZZAS_PER_COOK);
+
+  manager.drain();
+  return passed;
+}
+} // namespace
+
+int main() {
+  bool passed = true;
+  for (auto hosting : {Reception::KitchenHosting::Processes,
+                       Reception::KitchenHosting::Threads}) {
+    bool hostingPassed = checkResize(hosting);
+    std::cout << (hosting == Reception::KitchenHosting::Processes
+                      ? "processes"
+                      : "threads")
+              << ": " << (hostingPassed ? "ok" : "FAILED") << std::endl;
+    passed &= hostingPassed;
+  }
+  return passed ? 0 : 1;
+}